@@ -48,9 +48,15 @@ endif
 LOCAL_SRC_FILES := \
 	ArmnnDriver.cpp \
 	ArmnnPreparedModel.cpp \
+	BranchPartitioner.cpp \
+	CompactModel.cpp \
+	CostModel.cpp \
+	LayerSupportCache.cpp \
 	ModelToINetworkConverter.cpp \
 	RequestThread.cpp \
-	Utils.cpp
+	Utils.cpp \
+	WeightCompression.cpp \
+	WorkerPool.cpp
 
 LOCAL_STATIC_LIBRARIES := \
 	libneuralnetworks_common \
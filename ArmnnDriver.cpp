@@ -7,8 +7,12 @@
 
 #include "ArmnnDriver.hpp"
 #include "ArmnnPreparedModel.hpp"
+#include "BranchPartitioner.hpp"
+#include "CostModel.hpp"
 #include "ModelToINetworkConverter.hpp"
 #include "Utils.hpp"
+#include "WeightCompression.hpp"
+#include "WorkerPool.hpp"
 
 #include <log/log.h>
 #include "SystemPropertiesUtils.hpp"
@@ -24,6 +28,7 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/program_options.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <string>
@@ -40,6 +45,35 @@ const char *g_Float32PerformancePowerUsageName = "ArmNN.float32Performance.power
 const char *g_Quantized8PerformanceExecTimeName = "ArmNN.quantized8Performance.execTime";
 const char *g_Quantized8PerformancePowerUsageName = "ArmNN.quantized8Performance.powerUsage";
 
+const unsigned int g_NumHeaviestOperationsToReport = 10;
+
+// By default, branches doing less work than this aren't worth the overhead of running as separate networks
+const double g_DefaultMinBranchFlops = 1e6;
+
+// Only fully connected weights at least this large are worth compressing
+const double g_MinCompressedWeightBytes = 1024.0 * 1024.0;
+
+bool ParseComputeDevice(const std::string& name, armnn::Compute& computeDevice)
+{
+    if (name == "CpuRef")
+    {
+        computeDevice = armnn::Compute::CpuRef;
+    }
+    else if (name == "GpuAcc")
+    {
+        computeDevice = armnn::Compute::GpuAcc;
+    }
+    else if (name == "CpuAcc")
+    {
+        computeDevice = armnn::Compute::CpuAcc;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
 }; //namespace
 
 namespace armnn_driver
@@ -47,9 +81,16 @@ namespace armnn_driver
 
 DriverOptions::DriverOptions(armnn::Compute computeDevice)
 : m_ComputeDevice(computeDevice)
+, m_Backends{ computeDevice }
 , m_VerboseLogging(false)
 , m_UseAndroidNnCpuExecutor(false)
 , m_ClTunedParametersMode(armnn::IClTunedParameters::Mode::UseTunedParameters)
+, m_PartitionCostModel(false)
+, m_LogPartitionCostModel(false)
+, m_NumBranchWorkers(0)
+, m_MinBranchFlops(g_DefaultMinBranchFlops)
+, m_ConcurrentBranchEnqueue(false)
+, m_WeightCompressionReport(false)
 {
 }
 
@@ -58,6 +99,12 @@ DriverOptions::DriverOptions(int argc, char** argv)
 , m_VerboseLogging(false)
 , m_UseAndroidNnCpuExecutor(false)
 , m_ClTunedParametersMode(armnn::IClTunedParameters::Mode::UseTunedParameters)
+, m_PartitionCostModel(false)
+, m_LogPartitionCostModel(false)
+, m_NumBranchWorkers(0)
+, m_MinBranchFlops(g_DefaultMinBranchFlops)
+, m_ConcurrentBranchEnqueue(false)
+, m_WeightCompressionReport(false)
 {
     namespace po = boost::program_options;
 
@@ -69,7 +116,9 @@ DriverOptions::DriverOptions(int argc, char** argv)
     optionsDesc.add_options()
         ("compute,c",
          po::value<std::string>(&computeDeviceAsString)->default_value("GpuAcc"),
-         "Which device to run layers on by default. Possible values are: CpuRef, CpuAcc, GpuAcc")
+         "Which device to run layers on by default, optionally followed by a comma-separated list of devices to "
+         "fall back to for layers it can't run (e.g. CpuAcc,CpuRef). Possible values are: CpuRef, CpuAcc, GpuAcc. "
+         "Only CpuRef can currently be used as a fallback")
 
         ("verbose-logging,v",
          po::bool_switch(&m_VerboseLogging),
@@ -98,7 +147,37 @@ DriverOptions::DriverOptions(int argc, char** argv)
          "If 'UseTunedParameters' (the default), will read CL tuned parameters from the file specified by "
          "--cl-tuned-parameters-file. "
          "If 'UpdateTunedParameters', will also find the optimum parameters when preparing new networks and update "
-         "the file accordingly.");
+         "the file accordingly.")
+
+        ("partition-cost-model",
+         po::bool_switch(&m_PartitionCostModel),
+         "Declines supported operations whose estimated saving from running in the driver is outweighed by "
+         "the cost of copying tensors to and from the neighbouring unsupported operations")
+
+        ("log-partition-cost-model",
+         po::bool_switch(&m_LogPartitionCostModel),
+         "Logs the estimates behind each decision made by --partition-cost-model")
+
+        ("concurrent-branches",
+         po::value<unsigned int>(&m_NumBranchWorkers)->default_value(0),
+         "If 2 or more, models with independent branches (e.g. Inception blocks) are split into several networks, "
+         "and up to this many of them are run concurrently")
+
+        ("min-branch-flops",
+         po::value<double>(&m_MinBranchFlops)->default_value(g_DefaultMinBranchFlops),
+         "The estimated number of floating point operations below which a branch isn't worth running as a network "
+         "of its own with --concurrent-branches, and is merged into a neighbouring one")
+
+        ("concurrent-branch-enqueue",
+         po::bool_switch(&m_ConcurrentBranchEnqueue),
+         "Lets the branches run with --concurrent-branches call ArmNN concurrently. ArmNN doesn't document "
+         "IRuntime::EnqueueWorkload as safe to call concurrently, so by default only one branch runs in ArmNN "
+         "at a time, and only the scheduling of the branches is concurrent")
+
+        ("fc-weight-compression-report",
+         po::bool_switch(&m_WeightCompressionReport),
+         "Reports the memory saved and the accuracy lost by storing large fully connected weights as int8 "
+         "with a scale per row, for each model prepared");
 
 
     po::variables_map variablesMap;
@@ -112,23 +191,34 @@ DriverOptions::DriverOptions(int argc, char** argv)
         ALOGW("An error occurred attempting to parse program options: %s", e.what());
     }
 
-    if (computeDeviceAsString == "CpuRef")
-    {
-        m_ComputeDevice = armnn::Compute::CpuRef;
-    }
-    else if (computeDeviceAsString == "GpuAcc")
+    std::istringstream computeStream(computeDeviceAsString);
+    std::string computeDeviceName;
+    while (std::getline(computeStream, computeDeviceName, ','))
     {
-        m_ComputeDevice = armnn::Compute::GpuAcc;
-    }
-    else if (computeDeviceAsString == "CpuAcc")
-    {
-        m_ComputeDevice = armnn::Compute::CpuAcc;
+        armnn::Compute computeDevice;
+        if (!ParseComputeDevice(computeDeviceName, computeDevice))
+        {
+            ALOGW("Ignoring unknown compute device %s", computeDeviceName.c_str());
+        }
+        else if (!m_Backends.empty() && computeDevice != armnn::Compute::CpuRef)
+        {
+            // ArmNN can only place layers the default device doesn't support on the reference backend
+            ALOGW("Ignoring fallback compute device %s: only CpuRef can be used as a fallback",
+                computeDeviceName.c_str());
+        }
+        else if (std::find(m_Backends.begin(), m_Backends.end(), computeDevice) == m_Backends.end())
+        {
+            m_Backends.push_back(computeDevice);
+        }
     }
-    else
+
+    if (m_Backends.empty())
     {
         ALOGW("Requested unknown compute device %s. Defaulting to compute id %s",
             computeDeviceAsString.c_str(), GetComputeDeviceAsCString(m_ComputeDevice));
+        m_Backends.push_back(m_ComputeDevice);
     }
+    m_ComputeDevice = m_Backends[0];
 
     if (!unsupportedOperationsAsString.empty())
     {
@@ -189,7 +279,7 @@ ArmnnDriver::ArmnnDriver(DriverOptions options)
     try
     {
         armnn::IRuntime::CreationOptions options(m_Options.GetComputeDevice());
-        options.m_UseCpuRefAsFallback = false;
+        options.m_UseCpuRefAsFallback = m_Options.UseCpuRefAsFallback();
         if (!m_Options.GetClTunedParametersFile().empty())
         {
             m_ClTunedParameters = armnn::IClTunedParameters::Create(m_Options.GetClTunedParametersMode());
@@ -211,6 +301,15 @@ ArmnnDriver::ArmnnDriver(DriverOptions options)
     {
         ALOGE("ArmnnDriver: Failed to setup CL runtime: %s. Device will be unavailable.", error.what());
     }
+
+    if (m_Options.GetNumBranchWorkers() > 1)
+    {
+        m_BranchWorkerPool = std::make_shared<WorkerPool>(m_Options.GetNumBranchWorkers());
+        if (!m_Options.IsConcurrentBranchEnqueueEnabled())
+        {
+            m_BranchEnqueueMutex = std::make_shared<std::mutex>();
+        }
+    }
 }
 
 Return<void> ArmnnDriver::getCapabilities(V1_0::IDevice::getCapabilities_cb cb)
@@ -267,7 +366,7 @@ Return<void> ArmnnDriver::getSupportedOperations(const V1_0::Model& model, V1_0:
     }
 
     // Attempt to convert the model to an ArmNN input network (INetwork).
-    ModelToINetworkConverter modelConverter(m_Runtime->GetDeviceSpec().DefaultComputeDevice, model,
+    ModelToINetworkConverter modelConverter(m_Options.GetBackends(), model,
         m_Options.GetForcedUnsupportedOperations());
 
     if (modelConverter.GetConversionResult() != ConversionResult::Success
@@ -286,6 +385,12 @@ Return<void> ArmnnDriver::getSupportedOperations(const V1_0::Model& model, V1_0:
         result.push_back(operationSupported);
     }
 
+    // Avoid handing the framework partitions which are likely to be slower than not using the driver at all
+    if (m_Options.IsPartitionCostModelEnabled())
+    {
+        ApplyPartitionCostModel(model, result, m_Options.IsPartitionCostModelLoggingEnabled());
+    }
+
     cb(ErrorStatus::NONE, result);
     return Void();
 }
@@ -305,6 +410,39 @@ void NotifyCallbackAndCheck(const sp<IPreparedModelCallback>& callback, ErrorSta
     }
 }
 
+void LogOperationPlacement(const V1_0::Model& model, const ModelToINetworkConverter& modelConverter,
+                           const std::vector<armnn::Compute>& backends)
+{
+    if (backends.size() < 2)
+    {
+        return;
+    }
+
+    std::vector<unsigned int> numOperationsPerBackend(backends.size(), 0);
+    for (uint32_t operationIdx = 0; operationIdx < model.operations.size(); operationIdx++)
+    {
+        const armnn::Compute backend = modelConverter.GetOperationBackend(operationIdx);
+        const size_t backendIdx = std::find(backends.begin(), backends.end(), backend) - backends.begin();
+        if (backendIdx < backends.size())
+        {
+            ++numOperationsPerBackend[backendIdx];
+        }
+        if (backendIdx != 0)
+        {
+            ALOGV("ArmnnDriver::prepareModel: operation %u (%s) needs %s", operationIdx,
+                toString(model.operations[operationIdx].type).c_str(), armnn::GetComputeDeviceAsCString(backend));
+        }
+    }
+
+    std::stringstream placement;
+    for (size_t i = 0; i < backends.size(); ++i)
+    {
+        placement << (i > 0 ? ", " : "") << armnn::GetComputeDeviceAsCString(backends[i]) << ": "
+            << numOperationsPerBackend[i];
+    }
+    ALOGI("ArmnnDriver::prepareModel: operations per compute device: %s", placement.str().c_str());
+}
+
 Return<ErrorStatus> FailPrepareModel(ErrorStatus error,
     const std::string& message,
     const sp<IPreparedModelCallback>& callback)
@@ -354,71 +492,98 @@ Return<ErrorStatus> ArmnnDriver::prepareModel(const V1_0::Model& model,
         }
     }
 
-    // Deliberately ignore any unsupported operations requested by the options -
-    // at this point we're being asked to prepare a model that we've already declared support for
-    // and the operation indices may be different to those in getSupportedOperations anyway.
-    std::set<unsigned int> unsupportedOperations;
-    ModelToINetworkConverter modelConverter(m_Runtime->GetDeviceSpec().DefaultComputeDevice, model,
-        unsupportedOperations);
-
-    if (modelConverter.GetConversionResult() != ConversionResult::Success)
+    if (m_Options.IsWeightCompressionReportEnabled())
     {
-        FailPrepareModel(ErrorStatus::GENERAL_FAILURE, "ModelToINetworkConverter failed", cb);
-        return ErrorStatus::NONE;
+        const std::vector<WeightCompressionEstimate> estimates =
+            EstimateFullyConnectedWeightCompression(model, g_MinCompressedWeightBytes);
+        ALOGI("ArmnnDriver::prepareModel: %s", GetWeightCompressionReport(model, estimates).c_str());
     }
 
-    // optimize the network
-    armnn::IOptimizedNetworkPtr optNet(nullptr, nullptr);
-    try
-    {
-        optNet = armnn::Optimize(*modelConverter.GetINetwork(), m_Runtime->GetDeviceSpec());
-    }
-    catch (armnn::Exception& e)
+    // The model is only converted as a whole if it isn't run as several networks
+    std::unique_ptr<ArmnnPreparedModel> preparedModel;
+    if (m_BranchWorkerPool)
     {
-        std::stringstream message;
-        message << "armnn::Exception ("<<e.what()<<") caught from optimize.";
-        FailPrepareModel(ErrorStatus::GENERAL_FAILURE, message.str(), cb);
-        return ErrorStatus::NONE;
+        preparedModel = PrepareModelAsSubNetworks(model);
     }
 
-    // Check that the optimized network is valid.
-    if (!optNet)
+    if (!preparedModel)
     {
-        FailPrepareModel(ErrorStatus::GENERAL_FAILURE,
-            "ArmnnDriver::prepareModel: Invalid optimized network", cb);
-        return ErrorStatus::NONE;
-    }
+        // Deliberately ignore any unsupported operations requested by the options -
+        // at this point we're being asked to prepare a model that we've already declared support for
+        // and the operation indices may be different to those in getSupportedOperations anyway.
+        std::set<unsigned int> unsupportedOperations;
+        ModelToINetworkConverter modelConverter(m_Options.GetBackends(), model, unsupportedOperations);
+
+        if (modelConverter.GetConversionResult() != ConversionResult::Success)
+        {
+            FailPrepareModel(ErrorStatus::GENERAL_FAILURE, "ModelToINetworkConverter failed", cb);
+            return ErrorStatus::NONE;
+        }
 
-    // Export the optimized network graph to a dot file if an output dump directory
-    // has been specified in the drivers' arguments.
-    ExportNetworkGraphToDotFile(*optNet,
-                                m_Options.GetRequestInputsAndOutputsDumpDir(),
-                                model);
+        LogOperationPlacement(model, modelConverter, m_Options.GetBackends());
 
-    // load it into the runtime
-    armnn::NetworkId netId = 0;
-    try
-    {
-        if (m_Runtime->LoadNetwork(netId, std::move(optNet)) != armnn::Status::Success)
+        // Log the estimated cost of the model and its heaviest operations, and save it next to the network graph
+        if (m_Options.IsVerboseLoggingEnabled() || !m_Options.GetRequestInputsAndOutputsDumpDir().empty())
         {
-            return FailPrepareModel(ErrorStatus::GENERAL_FAILURE,
-                "ArmnnDriver::prepareModel: Network could not be loaded", cb);
+            const std::string costReport = GetCostReport(model, modelConverter.GetOperationCosts(),
+                modelConverter.GetOutputPermuteBytes(), g_NumHeaviestOperationsToReport);
+            ALOGV("ArmnnDriver::prepareModel: estimated cost:\n%s", costReport.c_str());
+            ExportCostReportToFile(costReport, m_Options.GetRequestInputsAndOutputsDumpDir(), model);
         }
-    }
-    catch (armnn::Exception& e)
-    {
-        std::stringstream message;
-        message << "armnn::Exception (" << e.what()<< ") caught from LoadNetwork.";
-        FailPrepareModel(ErrorStatus::GENERAL_FAILURE, message.str(), cb);
-        return ErrorStatus::NONE;
-    }
 
-    std::unique_ptr<ArmnnPreparedModel> preparedModel(new ArmnnPreparedModel(
-        netId,
-        m_Runtime.get(),
-        model,
-        m_Options.GetRequestInputsAndOutputsDumpDir()
-    ));
+        // optimize the network
+        armnn::IOptimizedNetworkPtr optNet(nullptr, nullptr);
+        try
+        {
+            optNet = armnn::Optimize(*modelConverter.GetINetwork(), m_Runtime->GetDeviceSpec());
+        }
+        catch (armnn::Exception& e)
+        {
+            std::stringstream message;
+            message << "armnn::Exception ("<<e.what()<<") caught from optimize.";
+            FailPrepareModel(ErrorStatus::GENERAL_FAILURE, message.str(), cb);
+            return ErrorStatus::NONE;
+        }
+
+        // Check that the optimized network is valid.
+        if (!optNet)
+        {
+            FailPrepareModel(ErrorStatus::GENERAL_FAILURE,
+                "ArmnnDriver::prepareModel: Invalid optimized network", cb);
+            return ErrorStatus::NONE;
+        }
+
+        // Export the optimized network graph to a dot file if an output dump directory
+        // has been specified in the drivers' arguments.
+        ExportNetworkGraphToDotFile(*optNet,
+                                    m_Options.GetRequestInputsAndOutputsDumpDir(),
+                                    model);
+
+        // load it into the runtime
+        armnn::NetworkId netId = 0;
+        try
+        {
+            if (m_Runtime->LoadNetwork(netId, std::move(optNet)) != armnn::Status::Success)
+            {
+                return FailPrepareModel(ErrorStatus::GENERAL_FAILURE,
+                    "ArmnnDriver::prepareModel: Network could not be loaded", cb);
+            }
+        }
+        catch (armnn::Exception& e)
+        {
+            std::stringstream message;
+            message << "armnn::Exception (" << e.what()<< ") caught from LoadNetwork.";
+            FailPrepareModel(ErrorStatus::GENERAL_FAILURE, message.str(), cb);
+            return ErrorStatus::NONE;
+        }
+
+        preparedModel.reset(new ArmnnPreparedModel(
+            netId,
+            m_Runtime.get(),
+            model,
+            m_Options.GetRequestInputsAndOutputsDumpDir()
+        ));
+    }
 
     // Run a single 'dummy' inference of the model. This means that CL kernels will get compiled (and tuned if
     // this is enabled) before the first 'real' inference which removes the overhead of the first inference.
@@ -444,6 +609,74 @@ Return<ErrorStatus> ArmnnDriver::prepareModel(const V1_0::Model& model,
     return ErrorStatus::NONE;
 }
 
+std::unique_ptr<ArmnnPreparedModel> ArmnnDriver::PrepareModelAsSubNetworks(const V1_0::Model& model)
+{
+    std::vector<ModelPartition> partitions = PartitionModelAtBranches(model, m_Options.GetMinBranchFlops());
+    if (partitions.empty())
+    {
+        return nullptr;
+    }
+
+    std::vector<SubNetwork> subNetworks;
+    auto unloadSubNetworks = [&]()
+    {
+        for (const SubNetwork& subNetwork : subNetworks)
+        {
+            m_Runtime->UnloadNetwork(subNetwork.m_NetworkId);
+        }
+    };
+
+    std::set<unsigned int> unsupportedOperations;
+    for (const ModelPartition& partition : partitions)
+    {
+        ModelToINetworkConverter modelConverter(m_Options.GetBackends(), partition.m_Model, unsupportedOperations);
+        if (modelConverter.GetConversionResult() != ConversionResult::Success)
+        {
+            ALOGW("ArmnnDriver::prepareModel: failed to convert a branch, running the model as a whole");
+            unloadSubNetworks();
+            return nullptr;
+        }
+        LogOperationPlacement(partition.m_Model, modelConverter, m_Options.GetBackends());
+
+        SubNetwork subNetwork;
+        try
+        {
+            armnn::IOptimizedNetworkPtr optNet =
+                armnn::Optimize(*modelConverter.GetINetwork(), m_Runtime->GetDeviceSpec());
+            if (!optNet || m_Runtime->LoadNetwork(subNetwork.m_NetworkId, std::move(optNet)) != armnn::Status::Success)
+            {
+                ALOGW("ArmnnDriver::prepareModel: failed to load a branch, running the model as a whole");
+                unloadSubNetworks();
+                return nullptr;
+            }
+        }
+        catch (armnn::Exception& e)
+        {
+            ALOGW("ArmnnDriver::prepareModel: armnn::Exception (%s) caught preparing a branch, "
+                "running the model as a whole", e.what());
+            unloadSubNetworks();
+            return nullptr;
+        }
+
+        subNetwork.m_InputOperands.assign(partition.m_Model.inputIndexes.begin(),
+                                          partition.m_Model.inputIndexes.end());
+        subNetwork.m_OutputOperands.assign(partition.m_Model.outputIndexes.begin(),
+                                           partition.m_Model.outputIndexes.end());
+        subNetwork.m_Dependencies = partition.m_Dependencies;
+        subNetworks.push_back(std::move(subNetwork));
+    }
+
+    ALOGV("ArmnnDriver::prepareModel: running the model as %zu networks on %u workers",
+        subNetworks.size(), m_BranchWorkerPool->GetNumWorkers());
+
+    return std::unique_ptr<ArmnnPreparedModel>(new ArmnnPreparedModel(std::move(subNetworks),
+        m_Runtime.get(),
+        model,
+        m_Options.GetRequestInputsAndOutputsDumpDir(),
+        m_BranchWorkerPool,
+        m_BranchEnqueueMutex));
+}
+
 Return<DeviceStatus> ArmnnDriver::getStatus()
 {
     ALOGV("ArmnnDriver::getStatus()");
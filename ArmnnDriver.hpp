@@ -10,8 +10,10 @@
 #include <armnn/ArmNN.hpp>
 
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 // For Android O, explicitly declare the V1_0 HAL namespace to shorten type declarations,
 // as the namespace is not defined in HalInterfaces.h.
@@ -28,23 +30,44 @@ public:
     DriverOptions(DriverOptions&& other) = default;
 
     armnn::Compute GetComputeDevice() const { return m_ComputeDevice; }
+    // The compute device followed by any fallbacks for layers it can't run, in order of preference
+    const std::vector<armnn::Compute>& GetBackends() const { return m_Backends; }
+    // Any fallback is necessarily CpuRef, as ArmNN can't place layers on any other
+    bool UseCpuRefAsFallback() const { return m_Backends.size() > 1; }
     bool IsVerboseLoggingEnabled() const { return m_VerboseLogging; }
     const std::string& GetRequestInputsAndOutputsDumpDir() const { return m_RequestInputsAndOutputsDumpDir; }
     bool UseAndroidNnCpuExecutor() const { return m_UseAndroidNnCpuExecutor; }
     const std::set<unsigned int>& GetForcedUnsupportedOperations() const { return m_ForcedUnsupportedOperations; }
     const std::string& GetClTunedParametersFile() const { return m_ClTunedParametersFile; }
     armnn::IClTunedParameters::Mode GetClTunedParametersMode() const { return m_ClTunedParametersMode; }
+    bool IsPartitionCostModelEnabled() const { return m_PartitionCostModel; }
+    bool IsPartitionCostModelLoggingEnabled() const { return m_LogPartitionCostModel; }
+    // The number of threads running independent branches of a model concurrently. Below 2, models are run as a whole.
+    unsigned int GetNumBranchWorkers() const { return m_NumBranchWorkers; }
+    double GetMinBranchFlops() const { return m_MinBranchFlops; }
+    bool IsConcurrentBranchEnqueueEnabled() const { return m_ConcurrentBranchEnqueue; }
+    bool IsWeightCompressionReportEnabled() const { return m_WeightCompressionReport; }
 
 private:
     armnn::Compute m_ComputeDevice;
+    std::vector<armnn::Compute> m_Backends;
     bool m_VerboseLogging;
     bool m_UseAndroidNnCpuExecutor;
     std::string m_RequestInputsAndOutputsDumpDir;
     std::set<unsigned int> m_ForcedUnsupportedOperations;
     std::string m_ClTunedParametersFile;
     armnn::IClTunedParameters::Mode m_ClTunedParametersMode;
+    bool m_PartitionCostModel;
+    bool m_LogPartitionCostModel;
+    unsigned int m_NumBranchWorkers;
+    double m_MinBranchFlops;
+    bool m_ConcurrentBranchEnqueue;
+    bool m_WeightCompressionReport;
 };
 
+class ArmnnPreparedModel;
+class WorkerPool;
+
 class ArmnnDriver : public V1_0::IDevice {
 public:
     ArmnnDriver(DriverOptions options);
@@ -57,9 +80,16 @@ public:
     virtual Return<DeviceStatus> getStatus() override;
 
 private:
+    /// Returns nullptr if the model has no independent branches worth running concurrently, or on failure
+    std::unique_ptr<ArmnnPreparedModel> PrepareModelAsSubNetworks(const V1_0::Model& model);
+
     armnn::IRuntimePtr m_Runtime;
     armnn::IClTunedParametersPtr m_ClTunedParameters;
     DriverOptions m_Options;
+    std::shared_ptr<WorkerPool> m_BranchWorkerPool;
+    // Serializes the calls to m_Runtime->EnqueueWorkload made by the branches of a model, unless they may run
+    // concurrently (see --concurrent-branch-enqueue)
+    std::shared_ptr<std::mutex> m_BranchEnqueueMutex;
 };
 
 }
@@ -20,6 +20,10 @@
 
 #include <cassert>
 #include <cinttypes>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
 
 using namespace android;
 
@@ -117,16 +121,203 @@ ArmnnPreparedModel::ArmnnPreparedModel(armnn::NetworkId networkId,
 {
 }
 
+ArmnnPreparedModel::ArmnnPreparedModel(std::vector<SubNetwork> subNetworks,
+    armnn::IRuntime* runtime,
+    const V1_0::Model& model,
+    const std::string& requestInputsAndOutputsDumpDir,
+    std::shared_ptr<WorkerPool> workerPool,
+    std::shared_ptr<std::mutex> enqueueMutex)
+: m_NetworkId(subNetworks.at(0).m_NetworkId)
+, m_Runtime(runtime)
+, m_Model(model)
+, m_RequestCount(0)
+, m_RequestInputsAndOutputsDumpDir(requestInputsAndOutputsDumpDir)
+, m_SubNetworks(std::move(subNetworks))
+, m_Dependents(m_SubNetworks.size())
+, m_WorkerPool(std::move(workerPool))
+, m_EnqueueMutex(std::move(enqueueMutex))
+{
+    assert(m_WorkerPool);
+    for (uint32_t i = 0; i < m_SubNetworks.size(); ++i)
+    {
+        for (uint32_t dependencyIdx : m_SubNetworks[i].m_Dependencies)
+        {
+            assert(dependencyIdx < i);
+            m_Dependents[dependencyIdx].push_back(i);
+        }
+    }
+}
+
 ArmnnPreparedModel::~ArmnnPreparedModel()
 {
-    //unload the network associated with this model
-    m_Runtime->UnloadNetwork(m_NetworkId);
+    //unload the network(s) associated with this model
+    if (m_SubNetworks.empty())
+    {
+        m_Runtime->UnloadNetwork(m_NetworkId);
+    }
+    for (const SubNetwork& subNetwork : m_SubNetworks)
+    {
+        m_Runtime->UnloadNetwork(subNetwork.m_NetworkId);
+    }
+}
+
+armnn::TensorInfo ArmnnPreparedModel::GetInputTensorInfo(unsigned int inputIndex) const
+{
+    return m_SubNetworks.empty() ? m_Runtime->GetInputTensorInfo(m_NetworkId, inputIndex)
+                                 : GetTensorInfoForOperand(m_Model.operands[m_Model.inputIndexes[inputIndex]]);
+}
+
+armnn::TensorInfo ArmnnPreparedModel::GetOutputTensorInfo(unsigned int outputIndex) const
+{
+    return m_SubNetworks.empty() ? m_Runtime->GetOutputTensorInfo(m_NetworkId, outputIndex)
+                                 : GetTensorInfoForOperand(m_Model.operands[m_Model.outputIndexes[outputIndex]]);
+}
+
+void ArmnnPreparedModel::Enqueue(const armnn::InputTensors& inputTensors, const armnn::OutputTensors& outputTensors)
+{
+    if (m_SubNetworks.empty())
+    {
+        m_Runtime->EnqueueWorkload(m_NetworkId, inputTensors, outputTensors);
+    }
+    else
+    {
+        EnqueueSubNetworks(inputTensors, outputTensors);
+    }
+}
+
+void ArmnnPreparedModel::EnqueueSubNetworks(const armnn::InputTensors& inputTensors,
+                                            const armnn::OutputTensors& outputTensors)
+{
+    const uint32_t numSubNetworks = static_cast<uint32_t>(m_SubNetworks.size());
+
+    // The model inputs and outputs are used in place. Other tensors passed between the sub-networks are held
+    // for the duration of the request.
+    std::unordered_map<uint32_t, void*> operandMemory;
+    for (const auto& inputTensor : inputTensors)
+    {
+        operandMemory[m_Model.inputIndexes[inputTensor.first]] = const_cast<void*>(inputTensor.second.GetMemoryArea());
+    }
+    for (const auto& outputTensor : outputTensors)
+    {
+        operandMemory[m_Model.outputIndexes[outputTensor.first]] = outputTensor.second.GetMemoryArea();
+    }
+
+    std::vector<std::vector<uint8_t>> intermediateStorage;
+    std::vector<armnn::OutputTensors> subNetworkOutputs(numSubNetworks);
+    for (uint32_t i = 0; i < numSubNetworks; ++i)
+    {
+        const SubNetwork& subNetwork = m_SubNetworks[i];
+        for (uint32_t j = 0; j < subNetwork.m_OutputOperands.size(); ++j)
+        {
+            const armnn::TensorInfo tensorInfo = m_Runtime->GetOutputTensorInfo(subNetwork.m_NetworkId, j);
+            auto memory = operandMemory.find(subNetwork.m_OutputOperands[j]);
+            if (memory == operandMemory.end())
+            {
+                intermediateStorage.emplace_back(tensorInfo.GetNumBytes());
+                memory = operandMemory.emplace(subNetwork.m_OutputOperands[j], intermediateStorage.back().data()).first;
+            }
+            subNetworkOutputs[i].emplace_back(j, armnn::Tensor(tensorInfo, memory->second));
+        }
+    }
+
+    std::vector<armnn::InputTensors> subNetworkInputs(numSubNetworks);
+    for (uint32_t i = 0; i < numSubNetworks; ++i)
+    {
+        const SubNetwork& subNetwork = m_SubNetworks[i];
+        for (uint32_t j = 0; j < subNetwork.m_InputOperands.size(); ++j)
+        {
+            const armnn::TensorInfo tensorInfo = m_Runtime->GetInputTensorInfo(subNetwork.m_NetworkId, j);
+            auto memory = operandMemory.find(subNetwork.m_InputOperands[j]);
+            if (memory == operandMemory.end())
+            {
+                throw armnn::Exception("No tensor provided for a sub-network input");
+            }
+            subNetworkInputs[i].emplace_back(j, armnn::ConstTensor(tensorInfo, memory->second));
+        }
+    }
+
+    // Run each sub-network as soon as those producing its inputs have finished. Once one fails,
+    // no more are started, but those already running are waited for.
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::vector<size_t> numDependenciesLeft(numSubNetworks);
+    unsigned int numRunning = 0;
+    bool anyFailed = false;
+    std::string errorMessage;
+
+    std::function<void(uint32_t)> run = [&](uint32_t i)
+    {
+        // Any exception escaping the task would terminate the driver, so every one fails the request instead
+        bool failed = true;
+        std::string message;
+        try
+        {
+            std::unique_lock<std::mutex> enqueueLock;
+            if (m_EnqueueMutex)
+            {
+                enqueueLock = std::unique_lock<std::mutex>(*m_EnqueueMutex);
+            }
+            m_Runtime->EnqueueWorkload(m_SubNetworks[i].m_NetworkId, subNetworkInputs[i], subNetworkOutputs[i]);
+            failed = false;
+        }
+        catch (std::exception& e)
+        {
+            message = e.what();
+        }
+        catch (...)
+        {
+            message = "unknown exception";
+        }
+
+        // The waiting thread may return as soon as it sees nothing running, so it is notified under the lock
+        std::unique_lock<std::mutex> lock(mutex);
+        if (failed && !anyFailed)
+        {
+            anyFailed = true;
+            errorMessage = boost::str(boost::format("sub-network %1% failed: %2%") % i % message);
+        }
+        if (!anyFailed)
+        {
+            for (uint32_t dependentIdx : m_Dependents[i])
+            {
+                if (--numDependenciesLeft[dependentIdx] == 0)
+                {
+                    ++numRunning;
+                    m_WorkerPool->Post([&run, dependentIdx] { run(dependentIdx); });
+                }
+            }
+        }
+        --numRunning;
+        finished.notify_all();
+    };
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (uint32_t i = 0; i < numSubNetworks; ++i)
+        {
+            numDependenciesLeft[i] = m_SubNetworks[i].m_Dependencies.size();
+            if (numDependenciesLeft[i] == 0)
+            {
+                ++numRunning;
+                m_WorkerPool->Post([&run, i] { run(i); });
+            }
+        }
+        finished.wait(lock, [&numRunning] { return numRunning == 0; });
+    }
+
+    if (anyFailed)
+    {
+        throw armnn::Exception(errorMessage);
+    }
 }
 
 Return<ErrorStatus> ArmnnPreparedModel::execute(const Request& request,
                                                 const ::android::sp<IExecutionCallback>& callback)
 {
-    ALOGV("ArmnnPreparedModel::execute(): %s", GetModelSummary(m_Model).c_str());
+    if (IsVerboseLoggingEnabled())
+    {
+        ALOGV("ArmnnPreparedModel::execute(): %s", GetModelSummary(m_Model).c_str());
+    }
     m_RequestCount++;
 
     if (callback.get() == nullptr) {
@@ -166,7 +357,7 @@ Return<ErrorStatus> ArmnnPreparedModel::execute(const Request& request,
         {
             const auto& inputArg = request.inputs[i];
 
-            const armnn::TensorInfo inputTensorInfo = m_Runtime->GetInputTensorInfo(m_NetworkId, i);
+            const armnn::TensorInfo inputTensorInfo = GetInputTensorInfo(i);
             const armnn::Tensor inputTensor = GetTensorForRequestArgument(inputArg, inputTensorInfo, *pMemPools);
             if (inputTensor.GetMemoryArea() == nullptr)
             {
@@ -182,7 +373,7 @@ Return<ErrorStatus> ArmnnPreparedModel::execute(const Request& request,
         {
             const auto& outputArg = request.outputs[i];
 
-            const armnn::TensorInfo outputTensorInfo = m_Runtime->GetOutputTensorInfo(m_NetworkId, i);
+            const armnn::TensorInfo outputTensorInfo = GetOutputTensorInfo(i);
             const armnn::Tensor outputTensor = GetTensorForRequestArgument(outputArg, outputTensorInfo, *pMemPools);
             if (outputTensor.GetMemoryArea() == nullptr)
             {
@@ -220,7 +411,7 @@ void ArmnnPreparedModel::ExecuteGraph(std::shared_ptr<std::vector<::android::nn:
     // run it
     try
     {
-        m_Runtime->EnqueueWorkload(m_NetworkId, *pInputTensors, *pOutputTensors);
+        Enqueue(*pInputTensors, *pOutputTensors);
     }
     catch (armnn::Exception& e)
     {
@@ -248,7 +439,7 @@ void ArmnnPreparedModel::ExecuteWithDummyInputs()
     armnn::InputTensors inputTensors;
     for (unsigned int i = 0; i < m_Model.inputIndexes.size(); i++)
     {
-        const armnn::TensorInfo inputTensorInfo = m_Runtime->GetInputTensorInfo(m_NetworkId, i);
+        const armnn::TensorInfo inputTensorInfo = GetInputTensorInfo(i);
         storage.emplace_back(inputTensorInfo.GetNumBytes());
         const armnn::ConstTensor inputTensor(inputTensorInfo, storage.back().data());
 
@@ -258,7 +449,7 @@ void ArmnnPreparedModel::ExecuteWithDummyInputs()
     armnn::OutputTensors outputTensors;
     for (unsigned int i = 0; i < m_Model.outputIndexes.size(); i++)
     {
-        const armnn::TensorInfo outputTensorInfo = m_Runtime->GetOutputTensorInfo(m_NetworkId, i);
+        const armnn::TensorInfo outputTensorInfo = GetOutputTensorInfo(i);
         storage.emplace_back(outputTensorInfo.GetNumBytes());
         const armnn::Tensor outputTensor(outputTensorInfo, storage.back().data());
 
@@ -267,7 +458,7 @@ void ArmnnPreparedModel::ExecuteWithDummyInputs()
 
     try
     {
-        m_Runtime->EnqueueWorkload(m_NetworkId, inputTensors, outputTensors);
+        Enqueue(inputTensors, outputTensors);
     }
     catch (armnn::Exception& e)
     {
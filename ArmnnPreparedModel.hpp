@@ -6,6 +6,7 @@
 #pragma once
 
 #include "RequestThread.hpp"
+#include "WorkerPool.hpp"
 
 #include "HalInterfaces.h"
 #include "NeuralNetworks.h"
@@ -13,12 +14,23 @@
 
 #include "ArmnnDriver.hpp"
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace armnn_driver
 {
 
+/// A network executing part of a model (see PartitionModelAtBranches)
+struct SubNetwork
+{
+    armnn::NetworkId      m_NetworkId;
+    std::vector<uint32_t> m_InputOperands;  ///< The model operand bound to each input of the network
+    std::vector<uint32_t> m_OutputOperands; ///< The model operand bound to each output of the network
+    std::vector<uint32_t> m_Dependencies;   ///< The sub-networks producing its inputs
+};
+
 class ArmnnPreparedModel : public IPreparedModel
 {
 public:
@@ -27,6 +39,16 @@ public:
                        const V1_0::Model& model,
                        const std::string& requestInputsAndOutputsDumpDir);
 
+    /// Executes the model as several networks, running those which don't depend on each other's results
+    /// concurrently on the given workers. The sub-networks must be in an order in which they can be executed.
+    /// If enqueueMutex isn't null, it is held by each sub-network while calling the runtime to run it.
+    ArmnnPreparedModel(std::vector<SubNetwork> subNetworks,
+                       armnn::IRuntime* runtime,
+                       const V1_0::Model& model,
+                       const std::string& requestInputsAndOutputsDumpDir,
+                       std::shared_ptr<WorkerPool> workerPool,
+                       std::shared_ptr<std::mutex> enqueueMutex);
+
     virtual ~ArmnnPreparedModel();
 
     virtual Return<ErrorStatus> execute(const Request& request,
@@ -41,11 +63,21 @@ public:
     /// Executes this model with dummy inputs (e.g. all zeroes).
     void ExecuteWithDummyInputs();
 
+    /// The number of networks the model is executed as
+    size_t GetNumNetworks() const { return m_SubNetworks.empty() ? 1 : m_SubNetworks.size(); }
+
 private:
 
     template <typename TensorBindingCollection>
     void DumpTensorsIfRequired(char const* tensorNamePrefix, const TensorBindingCollection& tensorBindings);
 
+    armnn::TensorInfo GetInputTensorInfo(unsigned int inputIndex) const;
+    armnn::TensorInfo GetOutputTensorInfo(unsigned int outputIndex) const;
+
+    /// Runs the network(s) on the given model inputs and outputs. Can throw armnn::Exception.
+    void Enqueue(const armnn::InputTensors& inputTensors, const armnn::OutputTensors& outputTensors);
+    void EnqueueSubNetworks(const armnn::InputTensors& inputTensors, const armnn::OutputTensors& outputTensors);
+
     armnn::NetworkId     m_NetworkId;
     armnn::IRuntime*     m_Runtime;
     V1_0::Model          m_Model;
@@ -54,6 +86,12 @@ private:
     static RequestThread m_RequestThread;
     uint32_t             m_RequestCount;
     const std::string&   m_RequestInputsAndOutputsDumpDir;
+
+    // Only used if the model is executed as several networks
+    std::vector<SubNetwork>            m_SubNetworks;
+    std::vector<std::vector<uint32_t>> m_Dependents;
+    std::shared_ptr<WorkerPool>        m_WorkerPool;
+    std::shared_ptr<std::mutex>        m_EnqueueMutex;
 };
 
 class AndroidNnCpuExecutorPreparedModel : public IPreparedModel
@@ -0,0 +1,256 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "BranchPartitioner.hpp"
+
+#include "CompactModel.hpp"
+#include "CostModel.hpp"
+
+#include <log/log.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace armnn_driver
+{
+
+namespace
+{
+
+uint32_t FindRoot(std::vector<uint32_t>& parents, uint32_t i)
+{
+    while (parents[i] != i)
+    {
+        parents[i] = parents[parents[i]];
+        i = parents[i];
+    }
+    return i;
+}
+
+// Returns the operations producing the (non-constant) inputs of an operation, once each
+std::vector<uint32_t> GetPredecessors(const CompactModel& compactModel, uint32_t operationIdx)
+{
+    std::vector<uint32_t> predecessors;
+    for (uint32_t operandIdx : compactModel.GetOperationInputs(operationIdx))
+    {
+        const int32_t producerIdx = compactModel.GetProducer(operandIdx);
+        if (producerIdx >= 0)
+        {
+            predecessors.push_back(static_cast<uint32_t>(producerIdx));
+        }
+    }
+    std::sort(predecessors.begin(), predecessors.end());
+    predecessors.erase(std::unique(predecessors.begin(), predecessors.end()), predecessors.end());
+    return predecessors;
+}
+
+// Returns the number of different operations using the outputs of an operation
+uint32_t GetNumSuccessors(const CompactModel& compactModel, uint32_t operationIdx)
+{
+    std::vector<uint32_t> successors;
+    for (uint32_t operandIdx : compactModel.GetOperationOutputs(operationIdx))
+    {
+        const IndexRange consumers = compactModel.GetConsumers(operandIdx);
+        successors.insert(successors.end(), consumers.begin(), consumers.end());
+    }
+    std::sort(successors.begin(), successors.end());
+    return static_cast<uint32_t>(std::unique(successors.begin(), successors.end()) - successors.begin());
+}
+
+} // anonymous namespace
+
+std::vector<ModelPartition> PartitionModelAtBranches(const V1_0::Model& model, double minPartitionFlops)
+{
+    const CompactModel compactModel(model);
+    const uint32_t numOperations = compactModel.GetNumOperations();
+
+    // Split the operations into segments: chains in which each operation only uses the result of the previous one,
+    // and is its only user. Segments therefore start after every fork and at every join. The operations are in
+    // execution order, so segments are created in an order in which they can be executed.
+    std::vector<uint32_t> segmentOfOperation(numOperations);
+    std::vector<uint32_t> lastOperationOfSegment;
+    std::vector<std::vector<uint32_t>> segmentPredecessors;
+    std::vector<double> segmentFlops;
+
+    for (uint32_t operationIdx = 0; operationIdx < numOperations; operationIdx++)
+    {
+        const std::vector<uint32_t> predecessors = GetPredecessors(compactModel, operationIdx);
+        if (predecessors.size() == 1 &&
+            GetNumSuccessors(compactModel, predecessors[0]) == 1 &&
+            lastOperationOfSegment[segmentOfOperation[predecessors[0]]] == predecessors[0])
+        {
+            const uint32_t segmentIdx = segmentOfOperation[predecessors[0]];
+            segmentOfOperation[operationIdx] = segmentIdx;
+            lastOperationOfSegment[segmentIdx] = operationIdx;
+        }
+        else
+        {
+            const uint32_t segmentIdx = static_cast<uint32_t>(lastOperationOfSegment.size());
+            segmentOfOperation[operationIdx] = segmentIdx;
+            lastOperationOfSegment.push_back(operationIdx);
+            segmentPredecessors.emplace_back();
+            segmentFlops.push_back(0.0);
+            for (uint32_t predecessorIdx : predecessors)
+            {
+                segmentPredecessors[segmentIdx].push_back(segmentOfOperation[predecessorIdx]);
+            }
+        }
+        segmentFlops[segmentOfOperation[operationIdx]] +=
+            EstimateOperationCost(model, model.operations[operationIdx]).m_Flops;
+    }
+
+    // Merge segments with a single predecessor into it, if either is too small to be worth a workload of its own.
+    // As the predecessor is the only way into the segment, this can't create a cycle between the partitions.
+    const uint32_t numSegments = static_cast<uint32_t>(segmentFlops.size());
+    std::vector<uint32_t> parents(numSegments);
+    std::iota(parents.begin(), parents.end(), 0);
+    for (uint32_t segmentIdx = 0; segmentIdx < numSegments; segmentIdx++)
+    {
+        std::vector<uint32_t> predecessors;
+        for (uint32_t predecessorIdx : segmentPredecessors[segmentIdx])
+        {
+            predecessors.push_back(FindRoot(parents, predecessorIdx));
+        }
+        std::sort(predecessors.begin(), predecessors.end());
+        predecessors.erase(std::unique(predecessors.begin(), predecessors.end()), predecessors.end());
+
+        if (predecessors.size() == 1 &&
+            (segmentFlops[segmentIdx] < minPartitionFlops || segmentFlops[predecessors[0]] < minPartitionFlops))
+        {
+            parents[segmentIdx] = predecessors[0];
+            segmentFlops[predecessors[0]] += segmentFlops[segmentIdx];
+        }
+    }
+
+    // Each remaining root is a partition. Roots are in execution order, as each depends only on earlier segments.
+    std::vector<uint32_t> partitionOfSegment(numSegments);
+    uint32_t numPartitions = 0;
+    for (uint32_t segmentIdx = 0; segmentIdx < numSegments; segmentIdx++)
+    {
+        const uint32_t rootIdx = FindRoot(parents, segmentIdx);
+        partitionOfSegment[segmentIdx] = rootIdx == segmentIdx ? numPartitions++ : partitionOfSegment[rootIdx];
+    }
+
+    std::vector<uint32_t> partitionOfOperation(numOperations);
+    for (uint32_t operationIdx = 0; operationIdx < numOperations; operationIdx++)
+    {
+        partitionOfOperation[operationIdx] = partitionOfSegment[segmentOfOperation[operationIdx]];
+    }
+
+    // Build the partitions
+    std::vector<ModelPartition> partitions(numPartitions);
+    std::vector<std::vector<uint32_t>> operationsOfPartition(numPartitions);
+    for (uint32_t operationIdx = 0; operationIdx < numOperations; operationIdx++)
+    {
+        operationsOfPartition[partitionOfOperation[operationIdx]].push_back(operationIdx);
+    }
+
+    for (uint32_t partitionIdx = 0; partitionIdx < numPartitions; partitionIdx++)
+    {
+        ModelPartition& partition = partitions[partitionIdx];
+        V1_0::Model& partitionModel = partition.m_Model;
+        partitionModel.operands = model.operands;
+        partitionModel.operandValues = model.operandValues;
+        partitionModel.pools = model.pools;
+
+        const std::vector<uint32_t>& operations = operationsOfPartition[partitionIdx];
+        partitionModel.operations.resize(operations.size());
+
+        std::vector<uint32_t> inputs;
+        std::vector<uint32_t> outputs;
+        for (uint32_t i = 0; i < operations.size(); i++)
+        {
+            const uint32_t operationIdx = operations[i];
+            partitionModel.operations[i] = model.operations[operationIdx];
+
+            for (uint32_t operandIdx : compactModel.GetOperationInputs(operationIdx))
+            {
+                const OperandLifeTime lifetime = compactModel.GetOperandLifeTime(operandIdx);
+                const int32_t producerIdx = compactModel.GetProducer(operandIdx);
+                const bool producedOutside = producerIdx < 0 ?
+                    lifetime == OperandLifeTime::MODEL_INPUT :
+                    partitionOfOperation[producerIdx] != partitionIdx;
+                if (producedOutside && std::find(inputs.begin(), inputs.end(), operandIdx) == inputs.end())
+                {
+                    inputs.push_back(operandIdx);
+                    if (producerIdx >= 0)
+                    {
+                        partition.m_Dependencies.push_back(partitionOfOperation[producerIdx]);
+                    }
+                }
+            }
+
+            for (uint32_t operandIdx : compactModel.GetOperationOutputs(operationIdx))
+            {
+                const IndexRange consumers = compactModel.GetConsumers(operandIdx);
+                const bool usedOutside = compactModel.GetOperandLifeTime(operandIdx) == OperandLifeTime::MODEL_OUTPUT ||
+                    std::any_of(consumers.begin(), consumers.end(),
+                        [&](uint32_t consumerIdx) { return partitionOfOperation[consumerIdx] != partitionIdx; });
+                if (usedOutside)
+                {
+                    outputs.push_back(operandIdx);
+                }
+            }
+        }
+
+        for (uint32_t operandIdx : inputs)
+        {
+            partitionModel.operands[operandIdx].lifetime = OperandLifeTime::MODEL_INPUT;
+        }
+        for (uint32_t operandIdx : outputs)
+        {
+            partitionModel.operands[operandIdx].lifetime = OperandLifeTime::MODEL_OUTPUT;
+        }
+        partitionModel.inputIndexes = inputs;
+        partitionModel.outputIndexes = outputs;
+
+        std::sort(partition.m_Dependencies.begin(), partition.m_Dependencies.end());
+        partition.m_Dependencies.erase(std::unique(partition.m_Dependencies.begin(), partition.m_Dependencies.end()),
+                                       partition.m_Dependencies.end());
+    }
+
+    // Partitions producing nothing used elsewhere only hold operations which don't contribute to the outputs,
+    // and nothing can depend on them
+    std::vector<uint32_t> newPartitionIndices(numPartitions);
+    std::vector<ModelPartition> livePartitions;
+    for (uint32_t partitionIdx = 0; partitionIdx < numPartitions; partitionIdx++)
+    {
+        newPartitionIndices[partitionIdx] = static_cast<uint32_t>(livePartitions.size());
+        if (partitions[partitionIdx].m_Model.outputIndexes.size() > 0)
+        {
+            livePartitions.push_back(std::move(partitions[partitionIdx]));
+            for (uint32_t& dependencyIdx : livePartitions.back().m_Dependencies)
+            {
+                dependencyIdx = newPartitionIndices[dependencyIdx];
+            }
+        }
+    }
+
+    // The partitions can only run concurrently if there is more than one order to run them in, i.e. if some
+    // partition doesn't depend directly on the one before it
+    bool anyConcurrentPartitions = false;
+    for (uint32_t partitionIdx = 1; partitionIdx < livePartitions.size(); partitionIdx++)
+    {
+        const std::vector<uint32_t>& dependencies = livePartitions[partitionIdx].m_Dependencies;
+        if (std::find(dependencies.begin(), dependencies.end(), partitionIdx - 1) == dependencies.end())
+        {
+            anyConcurrentPartitions = true;
+            break;
+        }
+    }
+
+    if (!anyConcurrentPartitions)
+    {
+        return {};
+    }
+
+    ALOGV("PartitionModelAtBranches: %zu operation(s) split into %zu partition(s)",
+        static_cast<size_t>(numOperations), livePartitions.size());
+    return livePartitions;
+}
+
+}
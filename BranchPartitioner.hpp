@@ -0,0 +1,37 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#pragma once
+
+#include "HalInterfaces.h"
+
+#include "ArmnnDriver.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// Part of a model which can be executed as a network of its own.
+struct ModelPartition
+{
+    /// A copy of the whole model holding only the partition's operations. Operand indices are unchanged:
+    /// the operands the partition reads from outside are its inputs, and those it produces for use outside
+    /// (or which are outputs of the whole model) are its outputs.
+    V1_0::Model           m_Model;
+    /// The earlier partitions producing its inputs
+    std::vector<uint32_t> m_Dependencies;
+};
+
+/// Splits a model at the points where its graph forks and joins, so that independent branches (e.g. those of
+/// an Inception block) are in different partitions. Partitions estimated to do less than @a minPartitionFlops
+/// are merged with their neighbours where possible, as each adds the overhead of a separate workload and copies
+/// of its inputs and outputs.
+/// The partitions are returned in an order in which they can be executed one after the other. No partitions
+/// are returned if none of them could be executed concurrently.
+std::vector<ModelPartition> PartitionModelAtBranches(const V1_0::Model& model, double minPartitionFlops);
+
+}
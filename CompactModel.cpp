@@ -0,0 +1,98 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#include "CompactModel.hpp"
+
+namespace armnn_driver
+{
+
+CompactModel::CompactModel(const V1_0::Model& model)
+{
+    const uint32_t numOperands = model.operands.size();
+    const uint32_t numOperations = model.operations.size();
+
+    m_OperandTypes.reserve(numOperands);
+    m_OperandLifeTimes.reserve(numOperands);
+    m_OperandScales.reserve(numOperands);
+    m_OperandZeroPoints.reserve(numOperands);
+    m_DimensionOffsets.reserve(numOperands + 1);
+
+    m_DimensionOffsets.push_back(0);
+    for (const Operand& operand : model.operands)
+    {
+        m_OperandTypes.push_back(operand.type);
+        m_OperandLifeTimes.push_back(operand.lifetime);
+        m_OperandScales.push_back(operand.scale);
+        m_OperandZeroPoints.push_back(operand.zeroPoint);
+        m_Dimensions.insert(m_Dimensions.end(), operand.dimensions.begin(), operand.dimensions.end());
+        m_DimensionOffsets.push_back(static_cast<uint32_t>(m_Dimensions.size()));
+    }
+
+    m_OperationTypes.reserve(numOperations);
+    m_OperationInputOffsets.reserve(numOperations + 1);
+    m_OperationOutputOffsets.reserve(numOperations + 1);
+    m_Producers.assign(numOperands, -1);
+
+    // Count the uses of each operand while flattening the operations, so the consumer lists can be laid out
+    std::vector<uint32_t> numConsumers(numOperands, 0);
+
+    m_OperationInputOffsets.push_back(0);
+    m_OperationOutputOffsets.push_back(0);
+    for (uint32_t operationIdx = 0; operationIdx < numOperations; operationIdx++)
+    {
+        const V1_0::Operation& operation = model.operations[operationIdx];
+        m_OperationTypes.push_back(operation.type);
+
+        for (uint32_t operandIdx : operation.inputs)
+        {
+            m_OperationInputs.push_back(operandIdx);
+            ++numConsumers[operandIdx];
+        }
+        m_OperationInputOffsets.push_back(static_cast<uint32_t>(m_OperationInputs.size()));
+
+        for (uint32_t operandIdx : operation.outputs)
+        {
+            m_OperationOutputs.push_back(operandIdx);
+            m_Producers[operandIdx] = static_cast<int32_t>(operationIdx);
+        }
+        m_OperationOutputOffsets.push_back(static_cast<uint32_t>(m_OperationOutputs.size()));
+    }
+
+    m_ConsumerOffsets.resize(numOperands + 1);
+    m_ConsumerOffsets[0] = 0;
+    for (uint32_t operandIdx = 0; operandIdx < numOperands; operandIdx++)
+    {
+        m_ConsumerOffsets[operandIdx + 1] = m_ConsumerOffsets[operandIdx] + numConsumers[operandIdx];
+    }
+
+    // Fill in operation order, so each operand's consumers are sorted
+    m_Consumers.resize(m_OperationInputs.size());
+    std::vector<uint32_t> nextConsumer(m_ConsumerOffsets.begin(), m_ConsumerOffsets.end() - 1);
+    for (uint32_t operationIdx = 0; operationIdx < numOperations; operationIdx++)
+    {
+        for (uint32_t operandIdx : GetOperationInputs(operationIdx))
+        {
+            m_Consumers[nextConsumer[operandIdx]++] = operationIdx;
+        }
+    }
+}
+
+uint64_t CompactModel::GetOperandNumElements(uint32_t operandIdx) const
+{
+    uint64_t numElements = 1;
+    for (uint32_t dim : GetOperandDimensions(operandIdx))
+    {
+        numElements *= dim;
+    }
+    return numElements;
+}
+
+bool CompactModel::IsOperandConstant(uint32_t operandIdx) const
+{
+    return m_OperandLifeTimes[operandIdx] == OperandLifeTime::CONSTANT_COPY ||
+           m_OperandLifeTimes[operandIdx] == OperandLifeTime::CONSTANT_REFERENCE;
+}
+
+}
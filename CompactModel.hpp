@@ -0,0 +1,105 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#pragma once
+
+#include "HalInterfaces.h"
+
+#include "ArmnnDriver.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// A contiguous range of operand or operation indices within a CompactModel.
+class IndexRange
+{
+public:
+    IndexRange(const uint32_t* begin, const uint32_t* end) : m_Begin(begin), m_End(end) {}
+
+    const uint32_t* begin() const { return m_Begin; }
+    const uint32_t* end() const { return m_End; }
+    uint32_t size() const { return static_cast<uint32_t>(m_End - m_Begin); }
+    bool empty() const { return m_Begin == m_End; }
+    uint32_t operator[](uint32_t i) const { return m_Begin[i]; }
+
+private:
+    const uint32_t* m_Begin;
+    const uint32_t* m_End;
+};
+
+/// A flat, structure-of-arrays copy of the structure of a V1_0::Model (without the operand values), built once
+/// per model for the graph analysis passes. Operand properties are held in dense per-operand arrays, and the
+/// inputs and outputs of each operation and the consumers of each operand in compressed sparse row (CSR) form:
+/// the entries for item i are at [offsets[i], offsets[i + 1]) of the corresponding index array.
+/// It reflects the model as it was when constructed.
+class CompactModel
+{
+public:
+    explicit CompactModel(const V1_0::Model& model);
+
+    uint32_t GetNumOperands() const { return static_cast<uint32_t>(m_OperandTypes.size()); }
+    uint32_t GetNumOperations() const { return static_cast<uint32_t>(m_OperationTypes.size()); }
+
+    OperandType GetOperandType(uint32_t operandIdx) const { return m_OperandTypes[operandIdx]; }
+    OperandLifeTime GetOperandLifeTime(uint32_t operandIdx) const { return m_OperandLifeTimes[operandIdx]; }
+    float GetOperandScale(uint32_t operandIdx) const { return m_OperandScales[operandIdx]; }
+    int32_t GetOperandZeroPoint(uint32_t operandIdx) const { return m_OperandZeroPoints[operandIdx]; }
+    IndexRange GetOperandDimensions(uint32_t operandIdx) const
+    {
+        return GetRange(m_Dimensions, m_DimensionOffsets, operandIdx);
+    }
+    uint32_t GetOperandRank(uint32_t operandIdx) const { return GetOperandDimensions(operandIdx).size(); }
+    uint64_t GetOperandNumElements(uint32_t operandIdx) const;
+    bool IsOperandConstant(uint32_t operandIdx) const;
+
+    /// Returns the operation producing an operand, or -1 if it isn't produced by an operation
+    /// (model inputs, constants and operands which are never written).
+    int32_t GetProducer(uint32_t operandIdx) const { return m_Producers[operandIdx]; }
+    /// Returns the operations using an operand, once per use.
+    IndexRange GetConsumers(uint32_t operandIdx) const
+    {
+        return GetRange(m_Consumers, m_ConsumerOffsets, operandIdx);
+    }
+
+    OperationType GetOperationType(uint32_t operationIdx) const { return m_OperationTypes[operationIdx]; }
+    IndexRange GetOperationInputs(uint32_t operationIdx) const
+    {
+        return GetRange(m_OperationInputs, m_OperationInputOffsets, operationIdx);
+    }
+    IndexRange GetOperationOutputs(uint32_t operationIdx) const
+    {
+        return GetRange(m_OperationOutputs, m_OperationOutputOffsets, operationIdx);
+    }
+
+private:
+    static IndexRange GetRange(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& offsets,
+                               uint32_t i)
+    {
+        return IndexRange(indices.data() + offsets[i], indices.data() + offsets[i + 1]);
+    }
+
+    // Per operand
+    std::vector<OperandType>     m_OperandTypes;
+    std::vector<OperandLifeTime> m_OperandLifeTimes;
+    std::vector<float>           m_OperandScales;
+    std::vector<int32_t>         m_OperandZeroPoints;
+    std::vector<int32_t>         m_Producers;
+    std::vector<uint32_t>        m_DimensionOffsets;
+    std::vector<uint32_t>        m_Dimensions;
+    std::vector<uint32_t>        m_ConsumerOffsets;
+    std::vector<uint32_t>        m_Consumers;
+
+    // Per operation
+    std::vector<OperationType>   m_OperationTypes;
+    std::vector<uint32_t>        m_OperationInputOffsets;
+    std::vector<uint32_t>        m_OperationInputs;
+    std::vector<uint32_t>        m_OperationOutputOffsets;
+    std::vector<uint32_t>        m_OperationOutputs;
+};
+
+}
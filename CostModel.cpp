@@ -0,0 +1,352 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "CostModel.hpp"
+
+#include "CompactModel.hpp"
+
+#include <boost/format.hpp>
+#include <log/log.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <set>
+#include <sstream>
+
+namespace armnn_driver
+{
+
+namespace
+{
+
+// Throughputs assumed for the framework's CPU path and for ArmNN. Only their ratios matter, so these are
+// deliberately round numbers rather than measurements of any particular device.
+const double g_CpuFlopsPerSecond      = 2.0e9;
+const double g_CpuBytesPerSecond      = 4.0e9;
+const double g_ArmnnFlopsPerSecond    = 2.0e10;
+const double g_ArmnnBytesPerSecond    = 1.0e10;
+
+// Cost of handing a tensor between the framework and the driver at a partition boundary:
+// a copy of the data, plus a fixed overhead for the synchronisation and memory mapping.
+const double g_TransferBytesPerSecond = 2.0e9;
+const double g_TransferOverheadSeconds = 50.0e-6;
+
+double GetOperandNumElements(const Operand& operand)
+{
+    return std::accumulate(operand.dimensions.begin(), operand.dimensions.end(), 1.0,
+        [](double product, uint32_t dim) { return product * dim; });
+}
+
+// A roofline estimate: an operation is limited by either its arithmetic or its memory traffic
+double EstimateSeconds(const OperationCost& cost, double flopsPerSecond, double bytesPerSecond)
+{
+    return std::max(cost.m_Flops / flopsPerSecond, cost.m_Bytes / bytesPerSecond);
+}
+
+double EstimateTransferSeconds(const Operand& operand)
+{
+    return GetOperandSizeInBytes(operand) / g_TransferBytesPerSecond + g_TransferOverheadSeconds;
+}
+
+// Simple union-find over operation indices, used to group supported operations into partitions
+uint32_t FindRoot(std::vector<uint32_t>& parents, uint32_t operationIdx)
+{
+    while (parents[operationIdx] != operationIdx)
+    {
+        parents[operationIdx] = parents[parents[operationIdx]];
+        operationIdx = parents[operationIdx];
+    }
+    return operationIdx;
+}
+
+} // anonymous namespace
+
+double GetOperandSizeInBytes(const Operand& operand)
+{
+    switch (operand.type)
+    {
+        case OperandType::TENSOR_FLOAT32:
+        case OperandType::TENSOR_INT32:
+            return GetOperandNumElements(operand) * 4.0;
+        case OperandType::TENSOR_QUANT8_ASYMM:
+        case OperandType::TENSOR_OEM_BYTE:
+            return GetOperandNumElements(operand);
+        default:
+            return 0.0;
+    }
+}
+
+OperationCost EstimateOperationCost(const V1_0::Model& model, const V1_0::Operation& operation)
+{
+    OperationCost cost;
+
+    for (uint32_t operandIdx : operation.inputs)
+    {
+        const Operand& operand = model.operands[operandIdx];
+        if (operand.lifetime == OperandLifeTime::CONSTANT_COPY ||
+            operand.lifetime == OperandLifeTime::CONSTANT_REFERENCE)
+        {
+            cost.m_WeightBytes += GetOperandSizeInBytes(operand);
+        }
+        else
+        {
+            cost.m_InputBytes += GetOperandSizeInBytes(operand);
+        }
+    }
+    for (uint32_t operandIdx : operation.outputs)
+    {
+        cost.m_OutputBytes += GetOperandSizeInBytes(model.operands[operandIdx]);
+    }
+    cost.m_Bytes = cost.m_WeightBytes + cost.m_InputBytes + cost.m_OutputBytes;
+
+    if (operation.inputs.empty() || operation.outputs.empty())
+    {
+        return cost;
+    }
+
+    const Operand& input = model.operands[operation.inputs[0]];
+    const Operand& output = model.operands[operation.outputs[0]];
+    const double numOutputElements = GetOperandNumElements(output);
+
+    // Number of multiply-accumulates per output element, from the weights where there are any
+    auto getWeightsElementsPerOutput = [&](uint32_t numLeadingDims)
+    {
+        if (operation.inputs.size() < 2)
+        {
+            return 1.0;
+        }
+        const hidl_vec<uint32_t>& weightsDims = model.operands[operation.inputs[1]].dimensions;
+        double product = 1.0;
+        for (uint32_t i = numLeadingDims; i < weightsDims.size(); ++i)
+        {
+            product *= weightsDims[i];
+        }
+        return product;
+    };
+
+    switch (operation.type)
+    {
+        case OperationType::CONV_2D:
+            // Weights are [ O, H, W, I ]
+            cost.m_Flops = 2.0 * numOutputElements * getWeightsElementsPerOutput(1);
+            break;
+        case OperationType::DEPTHWISE_CONV_2D:
+        {
+            // Weights are [ 1, H, W, O ]: each output element uses a single H x W filter plane
+            const hidl_vec<uint32_t>& weightsDims = model.operands[operation.inputs[1]].dimensions;
+            const double filterSize = weightsDims.size() == 4 ? double(weightsDims[1]) * weightsDims[2] : 1.0;
+            cost.m_Flops = 2.0 * numOutputElements * filterSize;
+            break;
+        }
+        case OperationType::FULLY_CONNECTED:
+            // Weights are [ num units, input size ]
+            cost.m_Flops = 2.0 * numOutputElements * getWeightsElementsPerOutput(1);
+            break;
+        case OperationType::LSTM:
+        {
+            // Each (float) weight is used in one multiply-accumulate per batch entry, for all the gates together
+            const double batchSize = input.dimensions.size() > 0 ? input.dimensions[0] : 1.0;
+            cost.m_Flops = 2.0 * batchSize * cost.m_WeightBytes / sizeof(float);
+            break;
+        }
+        case OperationType::AVERAGE_POOL_2D:
+        case OperationType::L2_POOL_2D:
+        case OperationType::MAX_POOL_2D:
+            // Every input element contributes to at least one window
+            cost.m_Flops = std::max(GetOperandNumElements(input), numOutputElements);
+            break;
+        case OperationType::LOCAL_RESPONSE_NORMALIZATION:
+        case OperationType::L2_NORMALIZATION:
+        case OperationType::SOFTMAX:
+        case OperationType::LOGISTIC:
+        case OperationType::TANH:
+            // A reduction and/or a transcendental function per element
+            cost.m_Flops = 8.0 * numOutputElements;
+            break;
+        case OperationType::RESHAPE:
+            cost.m_Flops = 0.0;
+            break;
+        default:
+            cost.m_Flops = numOutputElements;
+            break;
+    }
+
+    return cost;
+}
+
+double GetArithmeticIntensity(const OperationCost& cost)
+{
+    const double totalBytes = cost.m_Bytes + cost.m_PermuteBytes;
+    return totalBytes > 0.0 ? cost.m_Flops / totalBytes : 0.0;
+}
+
+std::string GetCostReport(const V1_0::Model& model, const std::vector<OperationCost>& costs,
+                          double outputPermuteBytes, unsigned int maxNumOperations)
+{
+    OperationCost total;
+    total.m_PermuteBytes = outputPermuteBytes;
+    for (const OperationCost& cost : costs)
+    {
+        total.m_Flops        += cost.m_Flops;
+        total.m_Bytes        += cost.m_Bytes;
+        total.m_WeightBytes  += cost.m_WeightBytes;
+        total.m_InputBytes   += cost.m_InputBytes;
+        total.m_OutputBytes  += cost.m_OutputBytes;
+        total.m_PermuteBytes += cost.m_PermuteBytes;
+    }
+
+    auto formatCost = [](const OperationCost& cost)
+    {
+        return boost::str(boost::format("%.3f MFLOP (%.3f MMAC), weights %.1f KB, in %.1f KB, out %.1f KB, "
+                                        "permutes %.1f KB, intensity %.2f FLOP/byte")
+                          % (cost.m_Flops / 1.0e6) % (cost.m_Flops / 2.0e6)
+                          % (cost.m_WeightBytes / 1024.0) % (cost.m_InputBytes / 1024.0)
+                          % (cost.m_OutputBytes / 1024.0) % (cost.m_PermuteBytes / 1024.0)
+                          % GetArithmeticIntensity(cost));
+    };
+
+    std::stringstream report;
+    report << "Total for " << costs.size() << " operation(s): " << formatCost(total) << std::endl;
+    if (outputPermuteBytes > 0.0)
+    {
+        report << "Model output layout conversions: " << outputPermuteBytes / 1024.0 << " KB" << std::endl;
+    }
+
+    std::vector<uint32_t> order(costs.size());
+    std::iota(order.begin(), order.end(), 0);
+    const size_t numReported = std::min<size_t>(maxNumOperations, order.size());
+    std::partial_sort(order.begin(), order.begin() + numReported, order.end(),
+        [&costs](uint32_t a, uint32_t b) { return costs[a].m_Flops > costs[b].m_Flops; });
+
+    report << "Heaviest " << numReported << " operation(s):" << std::endl;
+    for (size_t i = 0; i < numReported; ++i)
+    {
+        const uint32_t operationIdx = order[i];
+        const double share = total.m_Flops > 0.0 ? 100.0 * costs[operationIdx].m_Flops / total.m_Flops : 0.0;
+        report << "  " << operationIdx << " " << toString(model.operations[operationIdx].type) << ": "
+               << formatCost(costs[operationIdx]) << boost::str(boost::format(" (%.1f%% of FLOPs)") % share)
+               << std::endl;
+    }
+
+    return report.str();
+}
+
+void ApplyPartitionCostModel(const V1_0::Model& model, std::vector<bool>& supported, bool logDecisions)
+{
+    const uint32_t numOperations = model.operations.size();
+    if (supported.size() != numOperations)
+    {
+        return;
+    }
+
+    const CompactModel compactModel(model);
+
+    // Group supported operations which exchange tensors directly: these end up in the same partition
+    std::vector<uint32_t> parents(numOperations);
+    std::iota(parents.begin(), parents.end(), 0);
+    for (uint32_t operationIdx = 0; operationIdx < numOperations; operationIdx++)
+    {
+        if (!supported[operationIdx])
+        {
+            continue;
+        }
+        for (uint32_t operandIdx : compactModel.GetOperationInputs(operationIdx))
+        {
+            const int32_t producerIdx = compactModel.GetProducer(operandIdx);
+            if (producerIdx >= 0 && supported[producerIdx])
+            {
+                parents[FindRoot(parents, operationIdx)] = FindRoot(parents, static_cast<uint32_t>(producerIdx));
+            }
+        }
+    }
+
+    struct Partition
+    {
+        std::vector<uint32_t> m_Operations;
+        double m_SavedSeconds = 0.0;
+        std::set<uint32_t> m_BoundaryOperands;
+    };
+    std::map<uint32_t, Partition> partitions;
+
+    for (uint32_t operationIdx = 0; operationIdx < numOperations; operationIdx++)
+    {
+        if (!supported[operationIdx])
+        {
+            continue;
+        }
+
+        Partition& partition = partitions[FindRoot(parents, operationIdx)];
+        partition.m_Operations.push_back(operationIdx);
+
+        const OperationCost cost = EstimateOperationCost(model, model.operations[operationIdx]);
+        partition.m_SavedSeconds += EstimateSeconds(cost, g_CpuFlopsPerSecond, g_CpuBytesPerSecond) -
+                                    EstimateSeconds(cost, g_ArmnnFlopsPerSecond, g_ArmnnBytesPerSecond);
+
+        // Tensors exchanged with unsupported operations have to cross between the framework and the driver
+        for (uint32_t operandIdx : compactModel.GetOperationInputs(operationIdx))
+        {
+            const int32_t producerIdx = compactModel.GetProducer(operandIdx);
+            if (producerIdx >= 0 && !supported[producerIdx])
+            {
+                partition.m_BoundaryOperands.insert(operandIdx);
+            }
+        }
+    }
+
+    for (uint32_t operationIdx = 0; operationIdx < numOperations; operationIdx++)
+    {
+        if (supported[operationIdx])
+        {
+            continue;
+        }
+        for (uint32_t operandIdx : compactModel.GetOperationInputs(operationIdx))
+        {
+            const int32_t producerIdx = compactModel.GetProducer(operandIdx);
+            if (producerIdx >= 0 && supported[producerIdx])
+            {
+                partitions[FindRoot(parents, static_cast<uint32_t>(producerIdx))].m_BoundaryOperands.insert(operandIdx);
+            }
+        }
+    }
+
+    for (auto&& entry : partitions)
+    {
+        const Partition& partition = entry.second;
+
+        double transferSeconds = 0.0;
+        for (uint32_t operandIdx : partition.m_BoundaryOperands)
+        {
+            transferSeconds += EstimateTransferSeconds(model.operands[operandIdx]);
+        }
+
+        const bool accept = partition.m_SavedSeconds >= transferSeconds;
+
+        if (logDecisions)
+        {
+            std::string operations;
+            for (uint32_t operationIdx : partition.m_Operations)
+            {
+                operations += std::to_string(operationIdx) + ":" + toString(model.operations[operationIdx].type) + " ";
+            }
+            ALOGI("ApplyPartitionCostModel: %s partition [ %s] - estimated saving %.1f us, "
+                "%zu boundary tensor(s) costing %.1f us",
+                accept ? "accepting" : "declining", operations.c_str(),
+                partition.m_SavedSeconds * 1.0e6, partition.m_BoundaryOperands.size(), transferSeconds * 1.0e6);
+        }
+
+        if (!accept)
+        {
+            for (uint32_t operationIdx : partition.m_Operations)
+            {
+                supported[operationIdx] = false;
+            }
+        }
+    }
+}
+
+}
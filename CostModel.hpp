@@ -0,0 +1,50 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#pragma once
+
+#include "HalInterfaces.h"
+
+#include "ArmnnDriver.hpp"
+
+#include <string>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// Rough estimate of the work done by a single operation.
+struct OperationCost
+{
+    double m_Flops        = 0.0; ///< Arithmetic operations (2 per multiply-accumulate)
+    double m_Bytes        = 0.0; ///< Tensor data read and written, including weights
+    double m_WeightBytes  = 0.0; ///< Constant tensor data read (weights and biases)
+    double m_InputBytes   = 0.0; ///< Non-constant tensor data read
+    double m_OutputBytes  = 0.0; ///< Tensor data written
+    double m_PermuteBytes = 0.0; ///< Data read and written by layout conversions added for the operation
+};
+
+/// Arithmetic operations per byte of memory traffic, including any layout conversions.
+double GetArithmeticIntensity(const OperationCost& cost);
+
+/// Estimates the arithmetic and memory traffic of an operation from the shapes of its operands.
+OperationCost EstimateOperationCost(const V1_0::Model& model, const V1_0::Operation& operation);
+
+/// Returns the size in bytes of the data held by a tensor operand (0 for scalars).
+double GetOperandSizeInBytes(const Operand& operand);
+
+/// Returns a human-readable report of the total cost of a model and its @a maxNumOperations heaviest
+/// operations. @a costs has an entry per operation; @a outputPermuteBytes is the data moved by the
+/// layout conversions of the model outputs.
+std::string GetCostReport(const V1_0::Model& model, const std::vector<OperationCost>& costs,
+                          double outputPermuteBytes, unsigned int maxNumOperations);
+
+/// Declines groups of connected supported operations (the partitions the framework would give the driver)
+/// whose estimated saving from running in ArmNN is less than the cost of copying tensors across their
+/// boundaries with the unsupported operations around them. @a supported is updated in place.
+/// If @a logDecisions is set, the estimates behind each decision are logged.
+void ApplyPartitionCostModel(const V1_0::Model& model, std::vector<bool>& supported, bool logDecisions);
+
+}
@@ -0,0 +1,174 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#include "LayerSupportCache.hpp"
+
+namespace armnn_driver
+{
+
+namespace
+{
+
+// Every distinct query made by the driver is normally recorded; this only guards against unbounded growth
+// for a long-lived service that sees a great many different models.
+const size_t g_MaxNumCachedResults = 16384;
+
+} // anonymous namespace
+
+void LayerSupportQuery::AddBytes(const void* data, size_t numBytes)
+{
+    m_Key.append(static_cast<const char*>(data), numBytes);
+}
+
+void LayerSupportQuery::Add(const armnn::TensorShape& shape)
+{
+    Add(shape.GetNumDimensions());
+    for (unsigned int i = 0; i < shape.GetNumDimensions(); ++i)
+    {
+        Add(shape[i]);
+    }
+}
+
+void LayerSupportQuery::Add(const armnn::TensorInfo& info)
+{
+    Add(info.GetShape());
+    Add(info.GetDataType());
+    Add(info.GetQuantizationScale());
+    Add(info.GetQuantizationOffset());
+}
+
+void LayerSupportQuery::Add(const armnn::TensorInfo* info)
+{
+    Add(info != nullptr);
+    if (info != nullptr)
+    {
+        Add(*info);
+    }
+}
+
+void LayerSupportQuery::Add(const std::vector<const armnn::TensorInfo*>& infos)
+{
+    Add(static_cast<uint32_t>(infos.size()));
+    for (const armnn::TensorInfo* info : infos)
+    {
+        Add(info);
+    }
+}
+
+void LayerSupportQuery::Add(const armnn::ActivationDescriptor& desc)
+{
+    AddAll(desc.m_Function, desc.m_A, desc.m_B);
+}
+
+void LayerSupportQuery::Add(const armnn::SoftmaxDescriptor& desc)
+{
+    Add(desc.m_Beta);
+}
+
+void LayerSupportQuery::Add(const armnn::OriginsDescriptor& desc)
+{
+    AddAll(desc.GetNumViews(), desc.GetNumDimensions());
+    for (uint32_t view = 0; view < desc.GetNumViews(); ++view)
+    {
+        AddBytes(desc.GetViewOrigin(view), desc.GetNumDimensions() * sizeof(uint32_t));
+    }
+}
+
+void LayerSupportQuery::Add(const armnn::ViewsDescriptor& desc)
+{
+    AddAll(desc.GetNumViews(), desc.GetNumDimensions());
+    for (uint32_t view = 0; view < desc.GetNumViews(); ++view)
+    {
+        AddBytes(desc.GetViewOrigin(view), desc.GetNumDimensions() * sizeof(uint32_t));
+        AddBytes(desc.GetViewSizes(view), desc.GetNumDimensions() * sizeof(uint32_t));
+    }
+}
+
+void LayerSupportQuery::Add(const armnn::Pooling2dDescriptor& desc)
+{
+    AddAll(desc.m_PoolType, desc.m_PadLeft, desc.m_PadRight, desc.m_PadTop, desc.m_PadBottom,
+           desc.m_PoolWidth, desc.m_PoolHeight, desc.m_StrideX, desc.m_StrideY,
+           desc.m_OutputShapeRounding, desc.m_PaddingMethod);
+}
+
+void LayerSupportQuery::Add(const armnn::FullyConnectedDescriptor& desc)
+{
+    AddAll(desc.m_BiasEnabled, desc.m_TransposeWeightMatrix);
+}
+
+void LayerSupportQuery::Add(const armnn::Convolution2dDescriptor& desc)
+{
+    AddAll(desc.m_PadLeft, desc.m_PadRight, desc.m_PadTop, desc.m_PadBottom,
+           desc.m_StrideX, desc.m_StrideY, desc.m_BiasEnabled);
+}
+
+void LayerSupportQuery::Add(const armnn::DepthwiseConvolution2dDescriptor& desc)
+{
+    AddAll(desc.m_PadLeft, desc.m_PadRight, desc.m_PadTop, desc.m_PadBottom,
+           desc.m_StrideX, desc.m_StrideY, desc.m_BiasEnabled);
+}
+
+void LayerSupportQuery::Add(const armnn::NormalizationDescriptor& desc)
+{
+    AddAll(desc.m_NormChannelType, desc.m_NormMethodType, desc.m_NormSize, desc.m_Alpha, desc.m_Beta, desc.m_K);
+}
+
+LayerSupportCache& LayerSupportCache::GetInstance()
+{
+    static LayerSupportCache instance;
+    return instance;
+}
+
+bool LayerSupportCache::Find(const std::string& key, bool& isSupported)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_Results.find(key);
+    if (it == m_Results.end())
+    {
+        ++m_NumMisses;
+        return false;
+    }
+
+    ++m_NumHits;
+    isSupported = it->second.m_IsSupported;
+    m_UseOrder.splice(m_UseOrder.begin(), m_UseOrder, it->second.m_UsePosition);
+    return true;
+}
+
+void LayerSupportCache::Insert(const std::string& key, bool isSupported)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_Results.find(key);
+    if (it != m_Results.end())
+    {
+        it->second.m_IsSupported = isSupported;
+        m_UseOrder.splice(m_UseOrder.begin(), m_UseOrder, it->second.m_UsePosition);
+        return;
+    }
+
+    if (m_Results.size() >= g_MaxNumCachedResults)
+    {
+        m_Results.erase(*m_UseOrder.back());
+        m_UseOrder.pop_back();
+    }
+
+    // Keys don't move in the map when it rehashes, so the order can refer to them
+    it = m_Results.emplace(key, CachedResult{isSupported, m_UseOrder.end()}).first;
+    m_UseOrder.push_front(&it->first);
+    it->second.m_UsePosition = m_UseOrder.begin();
+}
+
+void LayerSupportCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Results.clear();
+    m_UseOrder.clear();
+    m_NumHits = 0;
+    m_NumMisses = 0;
+}
+
+}
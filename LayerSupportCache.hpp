@@ -0,0 +1,106 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#pragma once
+
+#include <armnn/ArmNN.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// Builds a canonical key from the arguments of an armnn::Is*Supported query: the bytes of its values, in order.
+/// Values are added field by field, so that padding in the descriptors never affects the key.
+class LayerSupportQuery
+{
+public:
+    const std::string& GetKey() const { return m_Key; }
+
+    void Add(uint32_t value) { AddBytes(&value, sizeof(value)); }
+    void Add(int32_t value)  { AddBytes(&value, sizeof(value)); }
+    void Add(uint64_t value) { AddBytes(&value, sizeof(value)); }
+    void Add(float value)    { AddBytes(&value, sizeof(value)); }
+    void Add(bool value)     { Add(static_cast<uint32_t>(value)); }
+    void Add(armnn::Compute value)               { Add(static_cast<uint32_t>(value)); }
+    void Add(armnn::DataType value)              { Add(static_cast<uint32_t>(value)); }
+    void Add(armnn::ActivationFunction value)    { Add(static_cast<uint32_t>(value)); }
+    void Add(armnn::PoolingAlgorithm value)      { Add(static_cast<uint32_t>(value)); }
+    void Add(armnn::OutputShapeRounding value)   { Add(static_cast<uint32_t>(value)); }
+    void Add(armnn::PaddingMethod value)         { Add(static_cast<uint32_t>(value)); }
+    void Add(armnn::NormalizationAlgorithmChannel value) { Add(static_cast<uint32_t>(value)); }
+    void Add(armnn::NormalizationAlgorithmMethod value)  { Add(static_cast<uint32_t>(value)); }
+
+    void Add(const armnn::TensorShape& shape);
+    void Add(const armnn::TensorInfo& info);
+    void Add(const armnn::TensorInfo* info);
+    void Add(const std::vector<const armnn::TensorInfo*>& infos);
+    void Add(const armnn::ActivationDescriptor& desc);
+    void Add(const armnn::SoftmaxDescriptor& desc);
+    void Add(const armnn::OriginsDescriptor& desc);
+    void Add(const armnn::ViewsDescriptor& desc);
+    void Add(const armnn::Pooling2dDescriptor& desc);
+    void Add(const armnn::FullyConnectedDescriptor& desc);
+    void Add(const armnn::Convolution2dDescriptor& desc);
+    void Add(const armnn::DepthwiseConvolution2dDescriptor& desc);
+    void Add(const armnn::NormalizationDescriptor& desc);
+
+    /// Adds each argument in turn
+    template<typename ... Args>
+    void AddAll(const Args&... args)
+    {
+        int expand[] = { 0, (Add(args), 0)... };
+        (void)expand;
+    }
+
+private:
+    void AddBytes(const void* data, size_t numBytes);
+
+    std::string m_Key;
+};
+
+/// Driver-wide record of the results of armnn::Is*Supported queries, so that identical queries made while
+/// converting different operations, or a model in both getSupportedOperations and prepareModel, are only
+/// answered by ArmNN once. Once full, the least recently used result is dropped for each new one.
+/// Safe to use from multiple threads.
+class LayerSupportCache
+{
+public:
+    static LayerSupportCache& GetInstance();
+
+    /// Returns true and sets @a isSupported if a result has been recorded for @a key (see LayerSupportQuery).
+    bool Find(const std::string& key, bool& isSupported);
+
+    void Insert(const std::string& key, bool isSupported);
+
+    void Clear();
+
+    uint64_t GetNumHits() const { return m_NumHits; }
+    uint64_t GetNumMisses() const { return m_NumMisses; }
+
+private:
+    LayerSupportCache() = default;
+
+    struct CachedResult
+    {
+        bool                                    m_IsSupported;
+        std::list<const std::string*>::iterator m_UsePosition;
+    };
+
+    std::mutex                                    m_Mutex;
+    std::unordered_map<std::string, CachedResult> m_Results;
+    // The keys of m_Results, most recently used first
+    std::list<const std::string*>                 m_UseOrder;
+    std::atomic<uint64_t>                         m_NumHits{0};
+    std::atomic<uint64_t>                         m_NumMisses{0};
+};
+
+}
@@ -6,13 +6,17 @@
 #define LOG_TAG "ArmnnDriver"
 
 #include "ModelToINetworkConverter.hpp"
+#include "LayerSupportCache.hpp"
 #include "OperationsUtils.h"
 
 #include <armnn/LayerSupport.hpp>
 #include <Permute.hpp>
 
 #include <log/log.h>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <limits>
 
 #include <boost/format.hpp>
 #include <boost/core/ignore_unused.hpp>
@@ -46,6 +50,7 @@ public:
         }
     }
     const armnn::TensorInfo& GetTensorInfo() const { return m_TensorInfo; }
+    armnn::IOutputSlot* GetOutputSlot() const { return m_OutputSlot; }
 
 private:
     armnn::IOutputSlot* m_OutputSlot;
@@ -68,29 +73,63 @@ static bool Fail(const char* formatStr, Args&&... args)
     return false;
 }
 
-// Convenience function to call an Is*Supported function and log caller name together with reason for lack of support.
-// Called as: IsLayerSupported(__func__, Is*Supported, a, b, c, d, e)
+// Convenience function to call an Is*Supported function for each backend in order of preference, and log caller
+// name together with reason for lack of support. The index of the backend that supports the layer is accumulated
+// into backendIndex, which so ends up referring to the least preferred backend needed by an operation's layers.
+// Results are memoized driver-wide, keyed on the function, the backend and the arguments.
+// Called as: IsLayerSupported(__func__, Is*Supported, backends, backendIndex, b, c, d, e)
 template<typename IsLayerSupportedFunc, typename ... Args>
-bool IsLayerSupported(const char* funcName, IsLayerSupportedFunc f, Args&&... args)
+bool IsLayerSupported(const char* funcName, IsLayerSupportedFunc f, const std::vector<armnn::Compute>& backends,
+                      size_t& backendIndex, Args&&... args)
 {
-    std::vector<char> unsupportedReason(1024+1);
-    bool isSupported = f(std::forward<Args>(args)..., unsupportedReason.data(), unsupportedReason.size()-1);
-    if(isSupported)
-    {
-        return true;
-    }
-    else
+    LayerSupportCache& cache = LayerSupportCache::GetInstance();
+
+    for (size_t i = 0; i < backends.size(); ++i)
     {
-        std::string sUnsupportedReason(unsupportedReason.data());
-        if (sUnsupportedReason.size() > 0)
+        LayerSupportQuery query;
+        query.Add(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(f)));
+        query.Add(backends[i]);
+        query.AddAll(args...);
+
+        bool isSupported = false;
+        if (cache.Find(query.GetKey(), isSupported))
         {
-            ALOGD("%s: not supported by armnn: %s", funcName, sUnsupportedReason.c_str());
-        } else
+            if (!isSupported)
+            {
+                ALOGD("%s: not supported by armnn on %s (cached)", funcName,
+                    armnn::GetComputeDeviceAsCString(backends[i]));
+            }
+        }
+        else
         {
-            ALOGD("%s: not supported by armnn", funcName);
+            // ArmNN only needs to format the reason if it will be logged
+            char unsupportedReason[1024+1];
+            unsupportedReason[0] = '\0';
+            const bool logReason = IsVerboseLoggingEnabled();
+            isSupported = f(backends[i], args..., logReason ? unsupportedReason : nullptr,
+                logReason ? sizeof(unsupportedReason)-1 : 0);
+            cache.Insert(query.GetKey(), isSupported);
+
+            if (!isSupported)
+            {
+                if (unsupportedReason[0] != '\0')
+                {
+                    ALOGD("%s: not supported by armnn on %s: %s", funcName,
+                        armnn::GetComputeDeviceAsCString(backends[i]), unsupportedReason);
+                } else
+                {
+                    ALOGD("%s: not supported by armnn on %s", funcName, armnn::GetComputeDeviceAsCString(backends[i]));
+                }
+            }
+        }
+
+        if (isSupported)
+        {
+            backendIndex = std::max(backendIndex, i);
+            return true;
         }
-        return false;
     }
+    return false;
 }
 
 armnn::TensorShape GetTensorShapeForOperand(const Operand& operand)
@@ -115,37 +154,6 @@ void CalcPadding(uint32_t input, uint32_t kernel, uint32_t stride, uint32_t& out
     outPadTail = boost::numeric_cast<uint32_t>(padTail);
 }
 
-bool ValidateBroadcast(const V1_0::Model& model, const V1_0::Operation& operation, uint32_t numInputs)
-{
-    assert(operation.inputs.size() > 0); // This should have been validated by the caller
-    // validateModel() has been called already so we know the operation.inputs indexes are valid within model.operands.
-    const Operand& firstInput = model.operands[operation.inputs[0]];
-
-    // We don't support broadcasting yet - we require all input operands to have the same shape
-    for (uint32_t i = 1; i < numInputs; ++i)
-    {
-        const Operand& otherInput = model.operands[operation.inputs[i]];
-
-        if (firstInput.dimensions.size() != otherInput.dimensions.size())
-        {
-            return Fail("%s: Broadcasting not supported (Input 0 dims: %i Input %i dims: %i)",
-                __func__, firstInput.dimensions.size(), i, otherInput.dimensions.size());
-        }
-
-        for (unsigned int d = 0; d < firstInput.dimensions.size(); ++d)
-        {
-            if (firstInput.dimensions[d] != otherInput.dimensions[d])
-            {
-                return Fail("%s: Broadcasting not supported (Dimension %i size mismatch. "
-                    "Input 0: %i Input %i: %i)",
-                    __func__, d, firstInput.dimensions[d], i, otherInput.dimensions[d]);
-            }
-        }
-    }
-
-    return true;
-}
-
 Shape GetOperandShape(const Operand& operand)
 {
     Shape shape;
@@ -175,10 +183,18 @@ void SanitizeBiasQuantizationScale(armnn::TensorInfo& biasInfo,
     }
 }
 
+// Weights at least this sparse are reported, with the proportion of blocks of this many consecutive weights
+// which are entirely zero
+const float g_SparseWeightsThreshold = 0.5f;
+const unsigned int g_SparseWeightsBlockSize = 4;
+
+// Depthwise convolutions are converted to convolutions of groups of this many channels when no preferred backend
+// can run them natively. Each group's weights are dense, so this multiplies the work by up to the group size.
+const unsigned int g_DepthwiseConvolutionGroupChannels = 8;
+
 const armnn::PermutationVector IdentityPermutation({ 0U, 1U, 2U, 3U });
 const armnn::PermutationVector NHWCToArmNN({ 0U, 2U, 3U, 1U });
 const armnn::PermutationVector ArmNNToNHWC({ 0U, 3U, 1U, 2U });
-const armnn::PermutationVector SwapDim1And2({ 0U, 2U, 1U, 3U });
 
 template <typename OSlot>
 armnn::IConnectableLayer& AddPermuteLayer(armnn::INetwork& network, OSlot& input,
@@ -199,26 +215,12 @@ armnn::IConnectableLayer& AddPermuteLayer(armnn::INetwork& network, OSlot& input
     return *layer;
 }
 
-armnn::IConnectableLayer& SwizzleInDeswizzleOut(armnn::INetwork& network, LayerInputHandle& input,
-                                                armnn::IConnectableLayer& firstLayer,
-                                                armnn::IConnectableLayer& lastLayer)
-{
-    // Add swizzle layer
-    armnn::IConnectableLayer& swizzleLayer = AddPermuteLayer(network, input, NHWCToArmNN);
-
-    // Connect swizzled input to layer
-    swizzleLayer.GetOutputSlot(0).Connect(firstLayer.GetInputSlot(0));
-
-    // Add deswizzle layer
-    armnn::IConnectableLayer& deswizzleLayer = AddPermuteLayer(network, lastLayer.GetOutputSlot(0), ArmNNToNHWC);
-
-    return deswizzleLayer;
-}
-
-armnn::IConnectableLayer& SwizzleInDeswizzleOut(armnn::INetwork& network, LayerInputHandle& input,
-                                                armnn::IConnectableLayer& layer)
+// Returns true if swizzling a 4D tensor of the given (AndroidNN) shape to the ArmNN layout leaves its elements
+// in the same order in memory, in which case the swizzle is equivalent to a reshape.
+bool IsSwizzleEquivalentToReshape(const armnn::TensorShape& shape)
 {
-    return SwizzleInDeswizzleOut(network, input, layer, layer);
+    assert(shape.GetNumDimensions() == 4);
+    return shape[3] == 1 || (shape[1] == 1 && shape[2] == 1);
 }
 
 bool ValidateConcatOutputShape(const std::vector<armnn::TensorShape> & inputShapes,
@@ -264,25 +266,407 @@ bool ValidateConcatOutputShape(const std::vector<armnn::TensorShape> & inputShap
     return true;
 }
 
-void SwizzleInputs(armnn::INetwork& network,
-                   std::vector<LayerInputHandle>& inputs,
-                   std::vector<armnn::TensorShape>& inputShapes,
-                   const armnn::PermutationVector& mapping)
+// Returns the number of groups of channelsPerGroup channels (the last one possibly smaller) in numChannels channels
+unsigned int GetNumChannelGroups(unsigned int numChannels, unsigned int channelsPerGroup)
+{
+    return (numChannels + channelsPerGroup - 1) / channelsPerGroup;
+}
+
+// Returns the shape of a swizzled (NCHW) tensor with the given number of channels
+armnn::TensorShape GetChannelShape(const armnn::TensorShape& shape, unsigned int numChannels = 1)
+{
+    return armnn::TensorShape({ shape[0], numChannels, shape[2], shape[3] });
+}
+
+// Returns the descriptor of a splitter of a swizzled (NCHW) tensor into groups of channelsPerGroup channels
+armnn::ViewsDescriptor CreateChannelSplitterDescriptor(const armnn::TensorShape& shape,
+                                                       unsigned int channelsPerGroup = 1)
+{
+    const unsigned int numGroups = GetNumChannelGroups(shape[1], channelsPerGroup);
+    armnn::ViewsDescriptor viewsDesc(numGroups, 4);
+    for (unsigned int g = 0; g < numGroups; ++g)
+    {
+        const unsigned int firstChannel = g * channelsPerGroup;
+        const unsigned int numChannels = std::min(channelsPerGroup, shape[1] - firstChannel);
+        for (unsigned int d = 0; d < 4; ++d)
+        {
+            viewsDesc.SetViewOriginCoord(g, d, d == 1 ? firstChannel : 0);
+            viewsDesc.SetViewSize(g, d, d == 1 ? numChannels : shape[d]);
+        }
+    }
+    return viewsDesc;
+}
+
+// Returns the info of a swizzled (NCHW) tensor in which each channel is repeated numReplicas times
+armnn::TensorInfo GetReplicatedChannelsInfo(const armnn::TensorInfo& info, unsigned int numReplicas)
+{
+    const armnn::TensorShape& shape = info.GetShape();
+    armnn::TensorInfo replicatedInfo = info;
+    replicatedInfo.SetShape(armnn::TensorShape({ shape[0], shape[1] * numReplicas, shape[2], shape[3] }));
+    return replicatedInfo;
+}
+
+// Reorders depthwise convolution weights [ M, I, H, W ] into the equivalent [ 1, I * M, H, W ] weights for
+// an input in which each channel is repeated M times: weights channel i * M + m are the weights [ m, i, :, : ].
+std::vector<uint8_t> FlattenDepthMultiplier(const armnn::ConstTensor& weights)
+{
+    const armnn::TensorShape& shape = weights.GetShape();
+    const unsigned int depthMultiplier = shape[0];
+    const unsigned int numInputChannels = shape[1];
+    const size_t channelBytes = shape[2] * shape[3] * armnn::GetDataTypeSize(weights.GetDataType());
+
+    const uint8_t* source = static_cast<const uint8_t*>(weights.GetMemoryArea());
+    std::vector<uint8_t> flattened(weights.GetNumBytes());
+    for (unsigned int m = 0; m < depthMultiplier; ++m)
+    {
+        for (unsigned int i = 0; i < numInputChannels; ++i)
+        {
+            std::copy_n(source + (m * numInputChannels + i) * channelBytes, channelBytes,
+                        flattened.data() + (i * depthMultiplier + m) * channelBytes);
+        }
+    }
+    return flattened;
+}
+
+// Returns the dense convolution weights [ n * M, n, H, W ] equivalent to depthwise convolution weights
+// [ M, I, H, W ] for the n input channels starting at firstChannel: output channel i * M + m only uses input
+// channel i, with the weights [ m, firstChannel + i, :, : ]. All other weights are zero.
+std::vector<uint8_t> ExpandDepthwiseWeightsToDense(const armnn::ConstTensor& weights, unsigned int firstChannel,
+                                                   unsigned int numChannels)
+{
+    const armnn::TensorShape& shape = weights.GetShape();
+    const unsigned int depthMultiplier = shape[0];
+    const unsigned int numInputChannels = shape[1];
+    const size_t channelBytes = shape[2] * shape[3] * armnn::GetDataTypeSize(weights.GetDataType());
+
+    // Zero is all-zero bytes in float, and the zero point for quantized weights
+    const uint8_t zero = weights.GetDataType() == armnn::DataType::QuantisedAsymm8 ?
+        static_cast<uint8_t>(weights.GetInfo().GetQuantizationOffset()) : 0;
+
+    const uint8_t* source = static_cast<const uint8_t*>(weights.GetMemoryArea());
+    std::vector<uint8_t> dense(numChannels * depthMultiplier * numChannels * channelBytes, zero);
+    for (unsigned int i = 0; i < numChannels; ++i)
+    {
+        for (unsigned int m = 0; m < depthMultiplier; ++m)
+        {
+            const size_t outputChannel = i * depthMultiplier + m;
+            std::copy_n(source + (m * numInputChannels + firstChannel + i) * channelBytes, channelBytes,
+                        dense.data() + (outputChannel * numChannels + i) * channelBytes);
+        }
+    }
+    return dense;
+}
+
+// The tensors of one group of channels of a depthwise convolution converted to a grouped convolution
+struct DepthwiseConvolutionGroup
+{
+    unsigned int      m_FirstChannel;
+    armnn::TensorInfo m_InputInfo;
+    armnn::TensorInfo m_OutputInfo;
+    armnn::TensorInfo m_WeightsInfo;
+    armnn::TensorInfo m_BiasInfo;
+};
+
+std::vector<DepthwiseConvolutionGroup> GetDepthwiseConvolutionGroups(const armnn::TensorInfo& inputInfo,
+    const armnn::TensorInfo& outputInfo, const armnn::ConstTensor& weights, const armnn::ConstTensor& bias)
+{
+    const armnn::TensorShape& weightsShape = weights.GetShape();
+    const unsigned int depthMultiplier = weightsShape[0];
+    const unsigned int numInputChannels = weightsShape[1];
+
+    std::vector<DepthwiseConvolutionGroup> groups;
+    for (unsigned int firstChannel = 0; firstChannel < numInputChannels;
+         firstChannel += g_DepthwiseConvolutionGroupChannels)
+    {
+        const unsigned int numChannels = std::min(g_DepthwiseConvolutionGroupChannels,
+                                                  numInputChannels - firstChannel);
+        DepthwiseConvolutionGroup group = { firstChannel, inputInfo, outputInfo, weights.GetInfo(), bias.GetInfo() };
+        group.m_InputInfo.SetShape(GetChannelShape(inputInfo.GetShape(), numChannels));
+        group.m_OutputInfo.SetShape(GetChannelShape(outputInfo.GetShape(), numChannels * depthMultiplier));
+        group.m_WeightsInfo.SetShape(armnn::TensorShape({ numChannels * depthMultiplier, numChannels,
+                                                          weightsShape[2], weightsShape[3] }));
+        group.m_BiasInfo.SetShape(armnn::TensorShape({ numChannels * depthMultiplier }));
+        groups.push_back(group);
+    }
+    return groups;
+}
+
+// Returns the convolution descriptor with the same padding and strides as a depthwise convolution descriptor
+armnn::Convolution2dDescriptor GetConvolutionDescriptor(const armnn::DepthwiseConvolution2dDescriptor& desc)
+{
+    armnn::Convolution2dDescriptor convDesc;
+    convDesc.m_PadLeft     = desc.m_PadLeft;
+    convDesc.m_PadRight    = desc.m_PadRight;
+    convDesc.m_PadTop      = desc.m_PadTop;
+    convDesc.m_PadBottom   = desc.m_PadBottom;
+    convDesc.m_StrideX     = desc.m_StrideX;
+    convDesc.m_StrideY     = desc.m_StrideY;
+    convDesc.m_BiasEnabled = desc.m_BiasEnabled;
+    return convDesc;
+}
+
+// Returns the 4-D view [outer, axis, inner, 1] of a tensor, where outer and inner are the products of the
+// dimensions before and after the concatenation axis. Concatenating the views of the inputs along dimension 1
+// lays out the data exactly as concatenating the inputs along the axis, and the merger supports dimension 1.
+armnn::TensorShape GetConcatViewShape(const armnn::TensorShape& shape, uint32_t concatAxis)
+{
+    assert(concatAxis < shape.GetNumDimensions());
+
+    unsigned int outer = 1;
+    for (unsigned int i = 0; i < concatAxis; ++i)
+    {
+        outer *= shape[i];
+    }
+
+    unsigned int inner = 1;
+    for (unsigned int i = concatAxis + 1; i < shape.GetNumDimensions(); ++i)
+    {
+        inner *= shape[i];
+    }
+
+    return armnn::TensorShape({ outer, shape[concatAxis], inner, 1 });
+}
+
+inline bool IsOperandConstant(const Operand& operand)
+{
+    return operand.lifetime == OperandLifeTime::CONSTANT_COPY ||
+           operand.lifetime == OperandLifeTime::CONSTANT_REFERENCE;
+}
+
+// Whether an operand is read from the output slot of a layer: the input layer for a model input, or the layer
+// producing it otherwise. A model output can also be read by later operations of the model, e.g. where a branch
+// was merged into the partition producing the operand but the other branches read it from outside.
+inline bool IsOperandFromLayer(const Operand& operand)
+{
+    return operand.lifetime == OperandLifeTime::TEMPORARY_VARIABLE ||
+           operand.lifetime == OperandLifeTime::MODEL_INPUT ||
+           operand.lifetime == OperandLifeTime::MODEL_OUTPUT;
+}
+
+// Reference implementation of the element-wise operations which can be evaluated at conversion time.
+bool EvaluateElementwise(V1_0::OperationType type, float input, float& output)
+{
+    switch (type)
+    {
+        case V1_0::OperationType::FLOOR:    output = std::floor(input); return true;
+        case V1_0::OperationType::RELU:     output = std::max(input, 0.0f); return true;
+        case V1_0::OperationType::RELU1:    output = std::min(std::max(input, -1.0f), 1.0f); return true;
+        case V1_0::OperationType::RELU6:    output = std::min(std::max(input, 0.0f), 6.0f); return true;
+        case V1_0::OperationType::LOGISTIC: output = 1.0f / (1.0f + std::exp(-input)); return true;
+        case V1_0::OperationType::TANH:     output = std::tanh(input); return true;
+        default: return false;
+    }
+}
+
+bool ApplyFusedActivation(ActivationFn activation, float& value)
+{
+    switch (activation)
+    {
+        case ActivationFn::kActivationNone:  return true;
+        case ActivationFn::kActivationRelu:  return EvaluateElementwise(V1_0::OperationType::RELU, value, value);
+        case ActivationFn::kActivationRelu1: return EvaluateElementwise(V1_0::OperationType::RELU1, value, value);
+        case ActivationFn::kActivationRelu6: return EvaluateElementwise(V1_0::OperationType::RELU6, value, value);
+        default: return false;
+    }
+}
+
+// Gets the fused activation function equivalent to a standalone activation operation.
+bool GetActivationFunctionForOperation(V1_0::OperationType type, ActivationFn& outActivationFunction)
+{
+    switch (type)
+    {
+        case V1_0::OperationType::RELU:     outActivationFunction = ActivationFn::kActivationRelu; return true;
+        case V1_0::OperationType::RELU1:    outActivationFunction = ActivationFn::kActivationRelu1; return true;
+        case V1_0::OperationType::RELU6:    outActivationFunction = ActivationFn::kActivationRelu6; return true;
+        case V1_0::OperationType::LOGISTIC: outActivationFunction = ActivationFn::kActivationSigmoid; return true;
+        case V1_0::OperationType::TANH:     outActivationFunction = ActivationFn::kActivationTanh; return true;
+        default: return false;
+    }
+}
+
+// Returns true for the operations whose last input is a fused activation function, applied by ProcessActivation.
+bool HasFusedActivationInput(V1_0::OperationType type)
+{
+    switch (type)
+    {
+        case V1_0::OperationType::ADD:
+        case V1_0::OperationType::MUL:
+        case V1_0::OperationType::CONV_2D:
+        case V1_0::OperationType::DEPTHWISE_CONV_2D:
+        case V1_0::OperationType::FULLY_CONNECTED:
+        case V1_0::OperationType::AVERAGE_POOL_2D:
+        case V1_0::OperationType::L2_POOL_2D:
+        case V1_0::OperationType::MAX_POOL_2D:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Checks the input can be broadcast to the output shape (dimensions are aligned on the right, and must
+// either match or be 1 in the input).
+bool IsBroadcastCompatible(const armnn::TensorShape& inputShape, const armnn::TensorShape& outputShape)
+{
+    if (inputShape.GetNumDimensions() > outputShape.GetNumDimensions())
+    {
+        return false;
+    }
+
+    const unsigned int rankDifference = outputShape.GetNumDimensions() - inputShape.GetNumDimensions();
+    for (unsigned int d = 0; d < inputShape.GetNumDimensions(); ++d)
+    {
+        if (inputShape[d] != 1 && inputShape[d] != outputShape[d + rankDifference])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks a constant holds either one value, or one value per channel (the channels being the last dimension of
+// the tensor it is broadcast to), i.e. every dimension but the last is 1.
+bool IsPerChannelConstantShape(const armnn::TensorShape& constantShape, const armnn::TensorShape& tensorShape)
+{
+    if (!IsBroadcastCompatible(constantShape, tensorShape))
+    {
+        return false;
+    }
+
+    const unsigned int numDimensions = constantShape.GetNumDimensions();
+    for (unsigned int d = 0; d + 1 < numDimensions; ++d)
+    {
+        if (constantShape[d] != 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns the index of the input element which is broadcast to the given output element.
+unsigned int GetBroadcastIndex(unsigned int outputIndex, const armnn::TensorShape& outputShape,
+                               const armnn::TensorShape& inputShape)
+{
+    const unsigned int rankDifference = outputShape.GetNumDimensions() - inputShape.GetNumDimensions();
+
+    unsigned int inputIndex = 0;
+    unsigned int inputStride = 1;
+    for (unsigned int d = outputShape.GetNumDimensions(); d-- > rankDifference;)
+    {
+        const unsigned int coordinate = outputIndex % outputShape[d];
+        outputIndex /= outputShape[d];
+
+        const unsigned int inputSize = inputShape[d - rankDifference];
+        inputIndex += (inputSize == 1 ? 0 : coordinate) * inputStride;
+        inputStride *= inputSize;
+    }
+    return inputIndex;
+}
+
+// Returns the descriptor of the ArmNN activation equivalent to an AndroidNN fused activation function
+bool GetActivationDescriptor(ActivationFn activation, armnn::ActivationDescriptor& activationDesc)
+{
+    switch (activation)
+    {
+        case ActivationFn::kActivationRelu:
+        {
+            activationDesc.m_Function = armnn::ActivationFunction::ReLu;
+            break;
+        }
+        case ActivationFn::kActivationRelu1:
+        {
+            activationDesc.m_Function = armnn::ActivationFunction::BoundedReLu;
+            activationDesc.m_A = 1.0f;
+            activationDesc.m_B = -1.0f;
+            break;
+        }
+        case ActivationFn::kActivationRelu6:
+        {
+            activationDesc.m_Function = armnn::ActivationFunction::BoundedReLu;
+            activationDesc.m_A = 6.0f;
+            break;
+        }
+        case ActivationFn::kActivationSigmoid:
+        {
+            activationDesc.m_Function = armnn::ActivationFunction::Sigmoid;
+            break;
+        }
+        case ActivationFn::kActivationTanh:
+        {
+            activationDesc.m_Function = armnn::ActivationFunction::TanH;
+            activationDesc.m_A = 1.0f;
+            activationDesc.m_B = 1.0f;
+            break;
+        }
+        default:
+        {
+            return Fail("%s: Invalid activation enum value %i", __func__, activation);
+        }
+    }
+    return true;
+}
+
+// Returns true if an activation would leave every value representable in a quantized tensor unchanged, as the
+// quantization of the result already clamps it to the activation's range.
+bool IsActivationRedundant(const armnn::TensorInfo& tensorInfo, const armnn::ActivationDescriptor& activationDesc)
+{
+    if (tensorInfo.GetDataType() != armnn::DataType::QuantisedAsymm8)
+    {
+        return false;
+    }
+
+    const float scale = tensorInfo.GetQuantizationScale();
+    const int32_t offset = tensorInfo.GetQuantizationOffset();
+    const float lowest = scale * static_cast<float>(std::numeric_limits<uint8_t>::min() - offset);
+    const float highest = scale * static_cast<float>(std::numeric_limits<uint8_t>::max() - offset);
+
+    switch (activationDesc.m_Function)
+    {
+        case armnn::ActivationFunction::ReLu:
+            return lowest >= 0.0f;
+        case armnn::ActivationFunction::BoundedReLu:
+            return lowest >= activationDesc.m_B && highest <= activationDesc.m_A;
+        default:
+            return false;
+    }
+}
+
+// Checks that the inputs of an elementwise operation broadcast to the shape of its output, following NumPy's rules:
+// dimensions are aligned from the last, and each must be 1 or the size of the corresponding output dimension.
+bool ValidateBroadcast(const V1_0::Model& model, const V1_0::Operation& operation, uint32_t numInputs)
 {
-    if (!mapping.IsEqual(IdentityPermutation))
+    assert(operation.inputs.size() >= numInputs && operation.outputs.size() > 0); // Validated by the caller
+    // validateModel() has been called already so we know the operation indexes are valid within model.operands.
+    const armnn::TensorShape outputShape = GetTensorShapeForOperand(model.operands[operation.outputs[0]]);
+
+    // Each output dimension must come from one of the inputs
+    std::vector<bool> outputDimensionMatched(outputShape.GetNumDimensions(), false);
+    for (uint32_t i = 0; i < numInputs; ++i)
+    {
+        const armnn::TensorShape inputShape = GetTensorShapeForOperand(model.operands[operation.inputs[i]]);
+        if (!IsBroadcastCompatible(inputShape, outputShape))
+        {
+            return Fail("%s: Input %i (%i dims) cannot be broadcast to the output (%i dims)",
+                __func__, i, inputShape.GetNumDimensions(), outputShape.GetNumDimensions());
+        }
+
+        const unsigned int rankDifference = outputShape.GetNumDimensions() - inputShape.GetNumDimensions();
+        for (unsigned int d = 0; d < inputShape.GetNumDimensions(); ++d)
+        {
+            outputDimensionMatched[d + rankDifference] = outputDimensionMatched[d + rankDifference] ||
+                                                         inputShape[d] == outputShape[d + rankDifference];
+        }
+    }
+
+    for (unsigned int d = 0; d < outputShape.GetNumDimensions(); ++d)
     {
-        size_t nInputs = inputs.size();
-        for (size_t i=0; i<nInputs; ++i)
+        if (!outputDimensionMatched[d] && outputShape[d] != 1)
         {
-            // add swizzle layer
-            armnn::IConnectableLayer& swizzleLayer = AddPermuteLayer(network, inputs[i], mapping);
-            auto& outputSlot = swizzleLayer.GetOutputSlot(0);
-            auto& outputInfo = outputSlot.GetTensorInfo();
-            // replace inputs with the swizzled ones
-            inputs[i] = LayerInputHandle(true, &outputSlot, outputInfo);
-            inputShapes[i] = inputs[i].GetTensorInfo().GetShape();
+            return Fail("%s: Output dimension %i (%i) does not match any input", __func__, d, outputShape[d]);
         }
     }
+
+    return true;
 }
 
 } // namespace
@@ -309,10 +693,10 @@ public:
         const bool needsSwizzling = (mappings.GetSize() > 0);
         if (needsSwizzling)
         {
-            m_SwizzledTensorData.resize(tensorInfo.GetNumBytes());
-            SwizzleAndroidNn4dTensorToArmNn(tensorInfo, valueStart, m_SwizzledTensorData.data(), mappings);
+            m_OwnedTensorData.resize(tensorInfo.GetNumBytes());
+            SwizzleAndroidNn4dTensorToArmNn(tensorInfo, valueStart, m_OwnedTensorData.data(), mappings);
 
-            m_ConstTensor = armnn::ConstTensor(armnnUtils::Permuted(tensorInfo, mappings), m_SwizzledTensorData.data());
+            m_ConstTensor = armnn::ConstTensor(armnnUtils::Permuted(tensorInfo, mappings), m_OwnedTensorData.data());
         }
         else
         {
@@ -326,22 +710,55 @@ public:
     bool IsValid() const { return m_ConstTensor.GetMemoryArea() != nullptr; }
     const armnn::ConstTensor& GetConstTensor() const { return m_ConstTensor; }
 
+    // Returns the tensor data for modification, taking a copy first if it still references the model's memory.
+    void* GetMutableMemoryArea()
+    {
+        assert(IsValid());
+        if (m_OwnedTensorData.empty())
+        {
+            const uint8_t* data = static_cast<const uint8_t*>(m_ConstTensor.GetMemoryArea());
+            m_OwnedTensorData.assign(data, data + m_ConstTensor.GetNumBytes());
+            m_ConstTensor = armnn::ConstTensor(m_ConstTensor.GetInfo(), m_OwnedTensorData.data());
+        }
+        return m_OwnedTensorData.data();
+    }
+
 private:
     armnn::ConstTensor m_ConstTensor;
-    // Owned memory for swizzled tensor data, only required if the tensor needed
-    // swizzling. Otherwise, @ref m_ConstTensor will reference memory from one of
-    // the pools associated with the model being converted.
-    std::vector<uint8_t> m_SwizzledTensorData;
+    // Owned memory for the tensor data, only required if the tensor needed swizzling
+    // or has been modified. Otherwise, @ref m_ConstTensor will reference memory from
+    // one of the pools associated with the model being converted.
+    std::vector<uint8_t> m_OwnedTensorData;
 };
 
 ModelToINetworkConverter::ModelToINetworkConverter(armnn::Compute compute, const V1_0::Model& model,
     const std::set<unsigned int>& forcedUnsupportedOperations)
-    : m_Compute(compute)
+    : ModelToINetworkConverter(std::vector<armnn::Compute>{ compute }, model, forcedUnsupportedOperations)
+{
+}
+
+ModelToINetworkConverter::ModelToINetworkConverter(const std::vector<armnn::Compute>& backends,
+    const V1_0::Model& model,
+    const std::set<unsigned int>& forcedUnsupportedOperations)
+    : m_Backends(backends)
     , m_Model(model)
+    , m_OperandValues(model.operandValues.begin(), model.operandValues.end())
     , m_ForcedUnsupportedOperations(forcedUnsupportedOperations)
     , m_Network(nullptr, nullptr)
     , m_ConversionResult(ConversionResult::Success)
+    , m_OutputPermuteBytes(0.0)
+    , m_NumPermuteLayers(0)
+    , m_OperationBackendIndex(0)
+    , m_CurrentOperationIndex(0)
+    , m_NumWeights(0)
+    , m_NumZeroWeights(0)
 {
+    assert(!m_Backends.empty());
+
+    // The constant values are read from m_OperandValues instead: unlike a hidl_vec, it has spare capacity,
+    // so the passes adding constants don't copy all the existing ones each time
+    m_Model.operandValues = hidl_vec<uint8_t>();
+
     try
     {
         Convert();
@@ -356,7 +773,10 @@ ModelToINetworkConverter::ModelToINetworkConverter(armnn::Compute compute, const
 
 void ModelToINetworkConverter::Convert()
 {
-    ALOGV("ModelToINetworkConverter::Convert(): %s", GetModelSummary(m_Model).c_str());
+    if (IsVerboseLoggingEnabled())
+    {
+        ALOGV("ModelToINetworkConverter::Convert(): %s", GetModelSummary(m_Model).c_str());
+    }
 
     // map the memory pool into shared pointers
     m_MemPools.clear();
@@ -373,12 +793,37 @@ void ModelToINetworkConverter::Convert()
         totalPoolSize += pool.size();
     }
 
+    // Work out how operands flow between operations, and which operations don't contribute to any output
+    {
+        const CompactModel compactModel(m_Model);
+        BuildDefUseIndex(compactModel);
+        FindDeadOperations(compactModel);
+    }
+
+    // Evaluate any operations whose inputs are all constant now, rather than on every inference
+    FoldConstantOperations();
+
+    // Merge per-channel scales and offsets into the weights of the layers producing their input,
+    // then merge standalone activations into the layers producing their input
+    FoldChannelAffineOperations();
+    FuseActivations();
+
+    // Let reshapes read past the reshapes producing their input, as only the final shape matters
+    CollapseReshapes();
+
     // Create armnn::INetwork
     m_Network = armnn::INetwork::Create();
 
     // add operations to it
     // track which layer outputs each operand
     m_OutputSlotForOperand = std::vector<armnn::IOutputSlot*>(m_Model.operands.size(), nullptr);
+    m_SwizzledOutputSlotForOperand = std::vector<armnn::IOutputSlot*>(m_Model.operands.size(), nullptr);
+    m_NumPermuteLayers = 0;
+    m_OperationBackends = std::vector<armnn::Compute>(m_Model.operations.size(), m_Backends[0]);
+    m_OperationCosts = std::vector<OperationCost>(m_Model.operations.size());
+    m_OperationSupported = std::vector<bool>(m_Model.operations.size(), false);
+    m_OperandTensorInfos = std::vector<OperandTensorInfos>(m_Model.operands.size());
+    m_OutputPermuteBytes = 0.0;
 
     try
     {
@@ -411,6 +856,8 @@ void ModelToINetworkConverter::Convert()
     for (uint32_t operationIdx = 0; operationIdx < m_Model.operations.size(); operationIdx++)
     {
         const auto& operation = m_Model.operations[operationIdx];
+        m_OperationBackendIndex = 0;
+        m_CurrentOperationIndex = operationIdx;
 
         bool ok = true;
         if (m_ForcedUnsupportedOperations.find(operationIdx) != m_ForcedUnsupportedOperations.end())
@@ -419,7 +866,9 @@ void ModelToINetworkConverter::Convert()
             ok = false;
         }
 
-        if (ok)
+        // Dead operations don't need converting, folded operations have already been replaced by their
+        // (constant) result, and fused activations are added as part of their producer
+        if (ok && !IsOperationSkipped(operationIdx))
         {
             try
             {
@@ -438,7 +887,15 @@ void ModelToINetworkConverter::Convert()
         }
 
         // Store whether this operation was successfully converted.
-        m_OperationSupported.emplace(operationIdx, ok);
+        m_OperationSupported[operationIdx] = ok;
+        m_OperationBackends[operationIdx] = m_Backends[m_OperationBackendIndex];
+        if (ok && !IsOperationSkipped(operationIdx))
+        {
+            // Keep the cost of any layout conversions added while converting the operation
+            const double permuteBytes = m_OperationCosts[operationIdx].m_PermuteBytes;
+            m_OperationCosts[operationIdx] = EstimateOperationCost(m_Model, operation);
+            m_OperationCosts[operationIdx].m_PermuteBytes = permuteBytes;
+        }
 
         // Any single operation failing will fail the entire conversion.
         // We still need to continue and check the other ones.
@@ -447,6 +904,17 @@ void ModelToINetworkConverter::Convert()
             m_ConversionResult = ConversionResult::UnsupportedFeature;
         }
     }
+
+    SetMergedOperationSupport();
+
+    // Layout conversions added from here on are for the model outputs
+    m_CurrentOperationIndex = static_cast<uint32_t>(m_Model.operations.size());
+
+    const LayerSupportCache& supportCache = LayerSupportCache::GetInstance();
+    ALOGV("ModelToINetworkConverter::Convert(): layer support queries so far: %llu answered from cache, %llu evaluated",
+        static_cast<unsigned long long>(supportCache.GetNumHits()),
+        static_cast<unsigned long long>(supportCache.GetNumMisses()));
+
     try
     {
         if (m_ConversionResult == ConversionResult::Success)
@@ -459,8 +927,18 @@ void ModelToINetworkConverter::Convert()
                 const armnn::TensorInfo& tensor = GetTensorInfoForOperand(operand);
                 armnn::IConnectableLayer* layer = m_Network->AddOutputLayer(i);
 
-                assert(m_OutputSlotForOperand[outputIndex]);
-                m_OutputSlotForOperand[outputIndex]->Connect(layer->GetInputSlot(0));
+                // outputs must be in the AndroidNN layout, which may require a deswizzle
+                armnn::IOutputSlot* outputSlot = GetOutputSlotForOperand(outputIndex);
+                assert(outputSlot);
+                outputSlot->Connect(layer->GetInputSlot(0));
+            }
+
+            ALOGV("ModelToINetworkConverter::Convert(): %u permute layer(s) added to the network", m_NumPermuteLayers);
+            if (m_NumWeights > 0)
+            {
+                ALOGV("ModelToINetworkConverter::Convert(): %llu of %llu weights are zero",
+                    static_cast<unsigned long long>(m_NumZeroWeights),
+                    static_cast<unsigned long long>(m_NumWeights));
             }
         }
     }
@@ -471,28 +949,729 @@ void ModelToINetworkConverter::Convert()
     }
 }
 
-bool ModelToINetworkConverter::ConvertOperation(const V1_0::Operation& operation)
+void ModelToINetworkConverter::BuildDefUseIndex(const CompactModel& compactModel)
 {
-    switch (operation.type)
+    // A mutable copy, as the passes rewriting the model keep it up to date
+    const uint32_t numOperands = compactModel.GetNumOperands();
+    m_OperandProducers.resize(numOperands);
+    m_OperandConsumers.resize(numOperands);
+
+    for (uint32_t operandIdx = 0; operandIdx < numOperands; operandIdx++)
     {
-        case V1_0::OperationType::ADD: return ConvertAdd(operation);
-        case V1_0::OperationType::AVERAGE_POOL_2D: return ConvertAveragePool2d(operation);
-        case V1_0::OperationType::CONCATENATION: return ConvertConcatenation(operation);
-        case V1_0::OperationType::CONV_2D: return ConvertConv2d(operation);
-        case V1_0::OperationType::DEPTHWISE_CONV_2D: return ConvertDepthwiseConv2d(operation);
-        case V1_0::OperationType::FLOOR: return ConvertFloor(operation);
-        case V1_0::OperationType::FULLY_CONNECTED: return ConvertFullyConnected(operation);
-        case V1_0::OperationType::LOCAL_RESPONSE_NORMALIZATION: return ConvertLocalResponseNormalization(operation);
-        case V1_0::OperationType::LOGISTIC: return ConvertLogistic(operation);
-        case V1_0::OperationType::L2_NORMALIZATION: return ConvertL2Normalization(operation);
-        case V1_0::OperationType::L2_POOL_2D: return ConvertL2Pool2d(operation);
-        case V1_0::OperationType::MAX_POOL_2D: return ConvertMaxPool2d(operation);
-        case V1_0::OperationType::MUL: return ConvertMul(operation);
-        case V1_0::OperationType::RELU: return ConvertReLu(operation);
-        case V1_0::OperationType::RELU1: return ConvertReLu1(operation);
-        case V1_0::OperationType::RELU6: return ConvertReLu6(operation);
-        case V1_0::OperationType::SOFTMAX: return ConvertSoftmax(operation);
-        case V1_0::OperationType::TANH: return ConvertTanH(operation);
+        m_OperandProducers[operandIdx] = compactModel.GetProducer(operandIdx);
+
+        const IndexRange consumers = compactModel.GetConsumers(operandIdx);
+        m_OperandConsumers[operandIdx].assign(consumers.begin(), consumers.end());
+    }
+}
+
+void ModelToINetworkConverter::FindDeadOperations(const CompactModel& compactModel)
+{
+    // Walk back from the model outputs, marking every operation reached as live
+    std::vector<bool> live(compactModel.GetNumOperations(), false);
+    std::vector<uint32_t> operandsToVisit(m_Model.outputIndexes.begin(), m_Model.outputIndexes.end());
+
+    while (!operandsToVisit.empty())
+    {
+        const uint32_t operandIdx = operandsToVisit.back();
+        operandsToVisit.pop_back();
+
+        const int32_t producerIdx = compactModel.GetProducer(operandIdx);
+        if (producerIdx < 0 || live[producerIdx])
+        {
+            continue;
+        }
+
+        live[producerIdx] = true;
+        const IndexRange producerInputs = compactModel.GetOperationInputs(static_cast<uint32_t>(producerIdx));
+        operandsToVisit.insert(operandsToVisit.end(), producerInputs.begin(), producerInputs.end());
+    }
+
+    m_DeadOperations.clear();
+    for (uint32_t operationIdx = 0; operationIdx < compactModel.GetNumOperations(); operationIdx++)
+    {
+        if (!live[operationIdx])
+        {
+            m_DeadOperations.insert(operationIdx);
+        }
+    }
+
+    if (!m_DeadOperations.empty())
+    {
+        ALOGV("ModelToINetworkConverter::FindDeadOperations(): %zu operation(s) do not contribute to any output",
+            m_DeadOperations.size());
+    }
+}
+
+bool ModelToINetworkConverter::IsOperationSkipped(uint32_t operationIndex) const
+{
+    return m_DeadOperations.find(operationIndex) != m_DeadOperations.end() ||
+           m_FoldedOperations.find(operationIndex) != m_FoldedOperations.end() ||
+           m_FusedOperations.find(operationIndex) != m_FusedOperations.end();
+}
+
+void ModelToINetworkConverter::SetMergedOperationSupport()
+{
+    // An operation merged into another one runs as part of it, and one folded into a constant only matters to
+    // the operations using the constant, so each is supported where those are, on the least preferred of their
+    // backends. Only dead operations are supported regardless, as nothing runs them.
+    const uint32_t numOperations = static_cast<uint32_t>(m_Model.operations.size());
+    std::vector<bool> isSet(numOperations, false);
+
+    std::function<void(uint32_t)> setSupport = [&](uint32_t operationIdx)
+    {
+        if (isSet[operationIdx])
+        {
+            return;
+        }
+        isSet[operationIdx] = true;
+
+        std::vector<uint32_t> targets;
+        auto fused = m_FusedOperations.find(operationIdx);
+        if (fused != m_FusedOperations.end())
+        {
+            targets.push_back(fused->second);
+        }
+        else if (m_FoldedOperations.find(operationIdx) != m_FoldedOperations.end())
+        {
+            targets = m_OperandConsumers[m_Model.operations[operationIdx].outputs[0]];
+        }
+
+        if (targets.empty() || !m_OperationSupported[operationIdx])
+        {
+            return;
+        }
+
+        size_t backendIndex = 0;
+        for (uint32_t targetIdx : targets)
+        {
+            setSupport(targetIdx);
+            if (!m_OperationSupported[targetIdx])
+            {
+                m_OperationSupported[operationIdx] = false;
+                return;
+            }
+            const size_t targetBackendIndex = static_cast<size_t>(std::find(m_Backends.begin(), m_Backends.end(),
+                m_OperationBackends[targetIdx]) - m_Backends.begin());
+            backendIndex = std::max(backendIndex, targetBackendIndex);
+        }
+        m_OperationBackends[operationIdx] = m_Backends[backendIndex];
+    };
+
+    for (uint32_t operationIdx = 0; operationIdx < numOperations; operationIdx++)
+    {
+        setSupport(operationIdx);
+    }
+}
+
+uint32_t ModelToINetworkConverter::GetNumLiveConsumers(uint32_t operandIndex) const
+{
+    const std::vector<uint32_t>& consumers = m_OperandConsumers[operandIndex];
+    return static_cast<uint32_t>(std::count_if(consumers.begin(), consumers.end(),
+        [this](uint32_t operationIdx) { return m_DeadOperations.find(operationIdx) == m_DeadOperations.end(); }));
+}
+
+uint32_t ModelToINetworkConverter::AddOperand(const Operand& operand)
+{
+    // Must only be used before the per-operand output slot tables are set up
+    const uint32_t operandIdx = m_Model.operands.size();
+    m_Model.operands.resize(operandIdx + 1);
+    m_Model.operands[operandIdx] = operand;
+
+    m_OperandProducers.push_back(-1);
+    m_OperandConsumers.emplace_back();
+
+    return operandIdx;
+}
+
+void ModelToINetworkConverter::FoldConstantOperations()
+{
+    m_FoldedOperations.clear();
+
+    // Operations are in execution order, so the result of a folded operation can be used to fold its consumers
+    for (uint32_t operationIdx = 0; operationIdx < m_Model.operations.size(); operationIdx++)
+    {
+        if (m_ForcedUnsupportedOperations.find(operationIdx) != m_ForcedUnsupportedOperations.end() ||
+            IsOperationSkipped(operationIdx))
+        {
+            continue;
+        }
+
+        try
+        {
+            if (FoldConstantOperation(m_Model.operations[operationIdx]))
+            {
+                m_FoldedOperations.insert(operationIdx);
+            }
+        }
+        catch (UnsupportedOperand&)
+        {
+            // Not foldable - the operation will be converted (or rejected) as normal
+        }
+        catch (const armnn::InvalidArgumentException&)
+        {
+            // As above
+        }
+    }
+
+    if (!m_FoldedOperations.empty())
+    {
+        ALOGV("ModelToINetworkConverter::FoldConstantOperations(): %zu operation(s) folded into constants",
+            m_FoldedOperations.size());
+    }
+}
+
+bool ModelToINetworkConverter::FoldConstantOperation(const V1_0::Operation& operation)
+{
+    if (operation.outputs.size() != 1)
+    {
+        return false;
+    }
+
+    // Model outputs must be produced by a layer, so only intermediate results are folded
+    const Operand* output = GetOutputOperand(operation, 0);
+    if (!output || output->lifetime != OperandLifeTime::TEMPORARY_VARIABLE ||
+        !IsOperandTypeSupportedForTensors(output->type))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < operation.inputs.size(); ++i)
+    {
+        const Operand* input = GetInputOperand(operation, i);
+        if (!input || !IsOperandConstant(*input))
+        {
+            return false;
+        }
+    }
+
+    const armnn::TensorInfo outputInfo = GetTensorInfoForOperand(*output);
+    const unsigned int numElements = outputInfo.GetNumElements();
+    std::vector<uint8_t> outputData(outputInfo.GetNumBytes());
+    float* const outputValues = reinterpret_cast<float*>(outputData.data());
+
+    const Operand* input0 = GetInputOperand(operation, 0);
+    if (!input0)
+    {
+        return false;
+    }
+
+    switch (operation.type)
+    {
+        case V1_0::OperationType::ADD:
+        case V1_0::OperationType::MUL:
+        {
+            const Operand* input1 = GetInputOperand(operation, 1);
+            ActivationFn activation;
+            if (operation.inputs.size() != 3 ||
+                !input1 ||
+                input0->type != OperandType::TENSOR_FLOAT32 ||
+                input1->type != OperandType::TENSOR_FLOAT32 ||
+                output->type != OperandType::TENSOR_FLOAT32 ||
+                !GetInputActivationFunction(operation, 2, activation))
+            {
+                return false;
+            }
+
+            const armnn::TensorShape inputShape0 = GetTensorShapeForOperand(*input0);
+            const armnn::TensorShape inputShape1 = GetTensorShapeForOperand(*input1);
+            if (!IsBroadcastCompatible(inputShape0, outputInfo.GetShape()) ||
+                !IsBroadcastCompatible(inputShape1, outputInfo.GetShape()))
+            {
+                return false;
+            }
+
+            const float* inputValues0 = static_cast<const float*>(GetOperandValueReadOnlyAddress(*input0));
+            const float* inputValues1 = static_cast<const float*>(GetOperandValueReadOnlyAddress(*input1));
+            if (!inputValues0 || !inputValues1)
+            {
+                return false;
+            }
+
+            for (unsigned int i = 0; i < numElements; ++i)
+            {
+                const float a = inputValues0[GetBroadcastIndex(i, outputInfo.GetShape(), inputShape0)];
+                const float b = inputValues1[GetBroadcastIndex(i, outputInfo.GetShape(), inputShape1)];
+                float value = operation.type == V1_0::OperationType::ADD ? a + b : a * b;
+                if (!ApplyFusedActivation(activation, value))
+                {
+                    return false;
+                }
+                outputValues[i] = value;
+            }
+            break;
+        }
+        case V1_0::OperationType::RESHAPE:
+        {
+            // The data is unchanged, whatever its type
+            if (input0->type != output->type ||
+                input0->scale != output->scale ||
+                input0->zeroPoint != output->zeroPoint ||
+                GetTensorShapeForOperand(*input0).GetNumElements() != numElements)
+            {
+                return false;
+            }
+
+            const uint8_t* inputData = static_cast<const uint8_t*>(GetOperandValueReadOnlyAddress(*input0));
+            if (!inputData)
+            {
+                return false;
+            }
+            std::copy(inputData, inputData + outputData.size(), outputData.begin());
+            break;
+        }
+        case V1_0::OperationType::DEQUANTIZE:
+        {
+            if (input0->type != OperandType::TENSOR_QUANT8_ASYMM ||
+                output->type != OperandType::TENSOR_FLOAT32 ||
+                GetTensorShapeForOperand(*input0).GetNumElements() != numElements)
+            {
+                return false;
+            }
+
+            const uint8_t* inputValues = static_cast<const uint8_t*>(GetOperandValueReadOnlyAddress(*input0));
+            if (!inputValues)
+            {
+                return false;
+            }
+            for (unsigned int i = 0; i < numElements; ++i)
+            {
+                outputValues[i] = input0->scale * static_cast<float>(inputValues[i] - input0->zeroPoint);
+            }
+            break;
+        }
+        case V1_0::OperationType::FLOOR:
+        case V1_0::OperationType::RELU:
+        case V1_0::OperationType::RELU1:
+        case V1_0::OperationType::RELU6:
+        case V1_0::OperationType::LOGISTIC:
+        case V1_0::OperationType::TANH:
+        {
+            if (input0->type != OperandType::TENSOR_FLOAT32 ||
+                output->type != OperandType::TENSOR_FLOAT32 ||
+                GetTensorShapeForOperand(*input0).GetNumElements() != numElements)
+            {
+                return false;
+            }
+
+            const float* inputValues = static_cast<const float*>(GetOperandValueReadOnlyAddress(*input0));
+            if (!inputValues)
+            {
+                return false;
+            }
+            for (unsigned int i = 0; i < numElements; ++i)
+            {
+                EvaluateElementwise(operation.type, inputValues[i], outputValues[i]);
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+
+    // Turn the output into a constant holding the result. The input values are no longer referenced,
+    // so it is safe to grow the operand values here.
+    const uint32_t offset = AddOperandValues(outputData.data(), outputData.size());
+
+    Operand& foldedOperand = m_Model.operands[operation.outputs[0]];
+    foldedOperand.lifetime           = OperandLifeTime::CONSTANT_COPY;
+    foldedOperand.location.poolIndex = 0;
+    foldedOperand.location.offset    = offset;
+    foldedOperand.location.length    = outputData.size();
+
+    return true;
+}
+
+void ModelToINetworkConverter::FoldChannelAffineOperations()
+{
+    m_FusedOperations.clear();
+    m_ChannelAffineTransforms.clear();
+
+    auto isSkipped = [this](uint32_t operationIdx)
+    {
+        return m_ForcedUnsupportedOperations.find(operationIdx) != m_ForcedUnsupportedOperations.end() ||
+               IsOperationSkipped(operationIdx);
+    };
+
+    unsigned int numFolded = 0;
+    for (uint32_t producerIdx = 0; producerIdx < m_Model.operations.size(); producerIdx++)
+    {
+        V1_0::Operation& producer = m_Model.operations[producerIdx];
+        if ((producer.type != V1_0::OperationType::CONV_2D &&
+             producer.type != V1_0::OperationType::DEPTHWISE_CONV_2D &&
+             producer.type != V1_0::OperationType::FULLY_CONNECTED) ||
+            producer.inputs.size() < 4 || producer.outputs.size() != 1 ||
+            isSkipped(producerIdx))
+        {
+            continue;
+        }
+
+        // Only float weights are modified. Quantized weights would need requantizing, which can lose accuracy.
+        const Operand& weights = m_Model.operands[producer.inputs[1]];
+        const Operand& bias = m_Model.operands[producer.inputs[2]];
+        if (weights.type != OperandType::TENSOR_FLOAT32 || !IsOperandConstant(weights) ||
+            bias.type != OperandType::TENSOR_FLOAT32 || !IsOperandConstant(bias))
+        {
+            continue;
+        }
+
+        // Fold each MUL/ADD in turn, for as long as the chain continues
+        while (true)
+        {
+            const uint32_t intermediateIdx = producer.outputs[0];
+            const Operand& intermediate = m_Model.operands[intermediateIdx];
+            if (intermediate.lifetime != OperandLifeTime::TEMPORARY_VARIABLE ||
+                intermediate.dimensions.size() == 0 ||
+                GetNumLiveConsumers(intermediateIdx) != 1)
+            {
+                break;
+            }
+
+            // Nothing can be folded past an activation
+            ActivationFn producerActivationFunction;
+            if (!GetInputActivationFunction(producer, producer.inputs.size() - 1, producerActivationFunction) ||
+                producerActivationFunction != ActivationFn::kActivationNone)
+            {
+                break;
+            }
+
+            const std::vector<uint32_t>& consumers = m_OperandConsumers[intermediateIdx];
+            const uint32_t consumerIdx = *std::find_if(consumers.begin(), consumers.end(),
+                [this](uint32_t operationIdx) { return m_DeadOperations.find(operationIdx) == m_DeadOperations.end(); });
+            const V1_0::Operation& consumer = m_Model.operations[consumerIdx];
+            if ((consumer.type != V1_0::OperationType::MUL && consumer.type != V1_0::OperationType::ADD) ||
+                consumer.inputs.size() != 3 || consumer.outputs.size() != 1 ||
+                isSkipped(consumerIdx))
+            {
+                break;
+            }
+
+            // The other input must be a constant holding either one value, or one value per channel
+            // (the channels being the last dimension)
+            const uint32_t constantIdx =
+                consumer.inputs[0] == intermediateIdx ? consumer.inputs[1] : consumer.inputs[0];
+            const Operand& constant = m_Model.operands[constantIdx];
+            const Operand& output = m_Model.operands[consumer.outputs[0]];
+            const uint32_t numChannels = intermediate.dimensions[intermediate.dimensions.size() - 1];
+            const armnn::TensorShape constantShape = GetTensorShapeForOperand(constant);
+            if (constantIdx == intermediateIdx ||
+                !IsOperandConstant(constant) ||
+                constant.type != OperandType::TENSOR_FLOAT32 ||
+                output.type != OperandType::TENSOR_FLOAT32 ||
+                output.dimensions != intermediate.dimensions ||
+                !IsPerChannelConstantShape(constantShape, GetTensorShapeForOperand(intermediate)) ||
+                GetTensorShapeForOperand(bias).GetNumElements() != numChannels)
+            {
+                break;
+            }
+
+            const float* constantValues = static_cast<const float*>(GetOperandValueReadOnlyAddress(constant));
+            if (constantValues == nullptr)
+            {
+                break;
+            }
+
+            ChannelAffineTransform transform;
+            auto existingTransform = m_ChannelAffineTransforms.find(intermediateIdx);
+            if (existingTransform != m_ChannelAffineTransforms.end())
+            {
+                transform = std::move(existingTransform->second);
+                m_ChannelAffineTransforms.erase(existingTransform);
+            }
+            else
+            {
+                transform.m_Scales.assign(numChannels, 1.0f);
+                transform.m_Offsets.assign(numChannels, 0.0f);
+            }
+
+            for (uint32_t c = 0; c < numChannels; ++c)
+            {
+                const float value = constantValues[constantShape.GetNumElements() == 1 ? 0 : c];
+                if (consumer.type == V1_0::OperationType::MUL)
+                {
+                    transform.m_Scales[c] *= value;
+                    transform.m_Offsets[c] *= value;
+                }
+                else
+                {
+                    transform.m_Offsets[c] += value;
+                }
+            }
+
+            // Rewrite the producer to produce the consumer's output, with the consumer's activation function
+            const uint32_t outputIdx = consumer.outputs[0];
+            const uint32_t previousActivationIdx = producer.inputs[producer.inputs.size() - 1];
+            const uint32_t activationIdx = consumer.inputs[2];
+            std::vector<uint32_t>& previousActivationConsumers = m_OperandConsumers[previousActivationIdx];
+            previousActivationConsumers.erase(std::find(previousActivationConsumers.begin(),
+                                                        previousActivationConsumers.end(), producerIdx));
+            m_OperandConsumers[activationIdx].push_back(producerIdx);
+            producer.inputs[producer.inputs.size() - 1] = activationIdx;
+
+            m_OperandProducers[intermediateIdx] = -1;
+            m_OperandProducers[outputIdx] = producerIdx;
+            producer.outputs[0] = outputIdx;
+
+            m_ChannelAffineTransforms[outputIdx] = std::move(transform);
+            m_FusedOperations[consumerIdx] = producerIdx;
+            ++numFolded;
+        }
+    }
+
+    if (numFolded > 0)
+    {
+        ALOGV("ModelToINetworkConverter::FoldChannelAffineOperations(): %u MUL/ADD operation(s) folded into weights",
+            numFolded);
+    }
+}
+
+void ModelToINetworkConverter::LogWeightSparsity(const char* operationName, const ConstTensorPin& weightsPin)
+{
+    // Measuring reads every weight, so is only done when it will be logged
+    if (!IsVerboseLoggingEnabled())
+    {
+        return;
+    }
+
+    const WeightSparsity sparsity = MeasureWeightSparsity(weightsPin.GetConstTensor(), g_SparseWeightsBlockSize);
+    m_NumWeights += sparsity.m_NumElements;
+    m_NumZeroWeights += sparsity.m_NumZeros;
+
+    if (sparsity.GetZeroFraction() >= g_SparseWeightsThreshold)
+    {
+        // ArmNN only has dense kernels, so this is the most a block-sparse kernel could save
+        ALOGV("%s: operation %u: %u of %u weights (%.1f%%) are zero, %.1f%% of blocks of %u; skipping zero blocks "
+            "would save up to %.1f%% of the multiply-accumulates", operationName, m_CurrentOperationIndex,
+            sparsity.m_NumZeros, sparsity.m_NumElements, 100.0f * sparsity.GetZeroFraction(),
+            100.0f * sparsity.GetZeroBlockFraction(), g_SparseWeightsBlockSize,
+            100.0f * sparsity.GetZeroBlockFraction());
+    }
+}
+
+void ModelToINetworkConverter::ApplyChannelAffineTransform(const V1_0::Operation& operation,
+    ConstTensorPin& weightsPin,
+    ConstTensorPin& biasPin,
+    const std::function<unsigned int(unsigned int)>& getWeightChannel) const
+{
+    auto it = m_ChannelAffineTransforms.find(operation.outputs[0]);
+    if (it == m_ChannelAffineTransforms.end())
+    {
+        return;
+    }
+
+    const ChannelAffineTransform& transform = it->second;
+
+    float* weights = static_cast<float*>(weightsPin.GetMutableMemoryArea());
+    const unsigned int numWeights = weightsPin.GetConstTensor().GetNumElements();
+    for (unsigned int i = 0; i < numWeights; ++i)
+    {
+        weights[i] *= transform.m_Scales[getWeightChannel(i)];
+    }
+
+    float* bias = static_cast<float*>(biasPin.GetMutableMemoryArea());
+    for (unsigned int c = 0; c < transform.m_Scales.size(); ++c)
+    {
+        bias[c] = bias[c] * transform.m_Scales[c] + transform.m_Offsets[c];
+    }
+}
+
+void ModelToINetworkConverter::FuseActivations()
+{
+    unsigned int numFusedActivations = 0;
+
+    // The activation function operand added for each function, shared by all the producers it is fused into
+    std::map<ActivationFn, uint32_t> activationOperands;
+
+    auto isSkipped = [this](uint32_t operationIdx)
+    {
+        return m_ForcedUnsupportedOperations.find(operationIdx) != m_ForcedUnsupportedOperations.end() ||
+               IsOperationSkipped(operationIdx);
+    };
+
+    for (uint32_t operationIdx = 0; operationIdx < m_Model.operations.size(); operationIdx++)
+    {
+        const V1_0::Operation& activation = m_Model.operations[operationIdx];
+
+        ActivationFn activationFunction;
+        if (!GetActivationFunctionForOperation(activation.type, activationFunction) ||
+            activation.inputs.size() != 1 || activation.outputs.size() != 1 ||
+            isSkipped(operationIdx))
+        {
+            continue;
+        }
+
+        // The activation must be the only (live) consumer of an intermediate result
+        const uint32_t intermediateIdx = activation.inputs[0];
+        const int32_t producerIdx = m_OperandProducers[intermediateIdx];
+        if (producerIdx < 0 || GetNumLiveConsumers(intermediateIdx) != 1 ||
+            isSkipped(static_cast<uint32_t>(producerIdx)))
+        {
+            continue;
+        }
+
+        V1_0::Operation& producer = m_Model.operations[producerIdx];
+        ActivationFn producerActivationFunction;
+        if (!HasFusedActivationInput(producer.type) ||
+            producer.inputs.empty() || producer.outputs.size() != 1 ||
+            !GetInputActivationFunction(producer, producer.inputs.size() - 1, producerActivationFunction) ||
+            producerActivationFunction != ActivationFn::kActivationNone)
+        {
+            continue;
+        }
+
+        // The activation must not change the type or quantization of its input
+        const Operand& intermediate = m_Model.operands[intermediateIdx];
+        const Operand& output = m_Model.operands[activation.outputs[0]];
+        if (intermediate.lifetime != OperandLifeTime::TEMPORARY_VARIABLE ||
+            intermediate.type != output.type ||
+            intermediate.scale != output.scale ||
+            intermediate.zeroPoint != output.zeroPoint ||
+            intermediate.dimensions != output.dimensions)
+        {
+            continue;
+        }
+
+        // Rewrite the producer to apply the activation itself and produce the activation's output.
+        // The existing activation function operand may be used by other operations, so one added for this
+        // function (and only ever used by fused producers) is used instead.
+        auto activationOperandIt = activationOperands.find(activationFunction);
+        if (activationOperandIt == activationOperands.end())
+        {
+            const int32_t activationValue = static_cast<int32_t>(activationFunction);
+
+            Operand activationOperand = {};
+            activationOperand.type            = OperandType::INT32;
+            activationOperand.lifetime        = OperandLifeTime::CONSTANT_COPY;
+            activationOperand.location.offset = AddOperandValues(&activationValue, sizeof(activationValue));
+            activationOperand.location.length = sizeof(activationValue);
+
+            activationOperandIt = activationOperands.emplace(activationFunction, AddOperand(activationOperand)).first;
+        }
+
+        const uint32_t activationOperandIdx = activationOperandIt->second;
+        ++m_Model.operands[activationOperandIdx].numberOfConsumers;
+
+        const uint32_t previousActivationOperandIdx = producer.inputs[producer.inputs.size() - 1];
+        std::vector<uint32_t>& previousConsumers = m_OperandConsumers[previousActivationOperandIdx];
+        previousConsumers.erase(std::find(previousConsumers.begin(), previousConsumers.end(), producerIdx));
+        m_OperandConsumers[activationOperandIdx].push_back(producerIdx);
+        producer.inputs[producer.inputs.size() - 1] = activationOperandIdx;
+
+        m_OperandProducers[intermediateIdx] = -1;
+        m_OperandProducers[activation.outputs[0]] = producerIdx;
+        producer.outputs[0] = activation.outputs[0];
+
+        m_FusedOperations[operationIdx] = static_cast<uint32_t>(producerIdx);
+        ++numFusedActivations;
+    }
+
+    if (numFusedActivations > 0)
+    {
+        ALOGV("ModelToINetworkConverter::FuseActivations(): %u activation(s) fused into their producer",
+            numFusedActivations);
+    }
+}
+
+void ModelToINetworkConverter::CollapseReshapes()
+{
+    unsigned int numCollapsedReshapes = 0;
+
+    auto isSkipped = [this](uint32_t operationIdx)
+    {
+        return m_ForcedUnsupportedOperations.find(operationIdx) != m_ForcedUnsupportedOperations.end() ||
+               IsOperationSkipped(operationIdx);
+    };
+
+    for (uint32_t operationIdx = 0; operationIdx < m_Model.operations.size(); operationIdx++)
+    {
+        V1_0::Operation& operation = m_Model.operations[operationIdx];
+        if ((operation.type != OperationType::RESHAPE && operation.type != OperationType::FULLY_CONNECTED) ||
+            operation.inputs.empty() || isSkipped(operationIdx))
+        {
+            continue;
+        }
+
+        // The input must be an intermediate result produced by a reshape, and used by nothing else
+        const uint32_t intermediateIdx = operation.inputs[0];
+        const int32_t producerIdx = m_OperandProducers[intermediateIdx];
+        if (producerIdx < 0 || GetNumLiveConsumers(intermediateIdx) != 1 ||
+            isSkipped(static_cast<uint32_t>(producerIdx)))
+        {
+            continue;
+        }
+
+        const V1_0::Operation& producer = m_Model.operations[producerIdx];
+        if (producer.type != OperationType::RESHAPE || producer.inputs.empty() ||
+            m_Model.operands[intermediateIdx].lifetime != OperandLifeTime::TEMPORARY_VARIABLE)
+        {
+            continue;
+        }
+
+        const uint32_t sourceIdx = producer.inputs[0];
+        if (operation.type == OperationType::FULLY_CONNECTED)
+        {
+            // A fully connected layer flattens its input to [ dim 0, everything else ] itself, so the reshape
+            // can only be skipped if it doesn't change the outermost dimension
+            const hidl_vec<uint32_t>& intermediateDims = m_Model.operands[intermediateIdx].dimensions;
+            const hidl_vec<uint32_t>& sourceDims = m_Model.operands[sourceIdx].dimensions;
+            if (intermediateDims.size() != 2 || sourceDims.size() < 2 || sourceDims[0] != intermediateDims[0])
+            {
+                continue;
+            }
+        }
+
+        std::vector<uint32_t>& producerSourceConsumers = m_OperandConsumers[sourceIdx];
+        producerSourceConsumers.erase(
+            std::find(producerSourceConsumers.begin(), producerSourceConsumers.end(), producerIdx));
+        producerSourceConsumers.push_back(operationIdx);
+        operation.inputs[0] = sourceIdx;
+
+        m_FusedOperations[static_cast<uint32_t>(producerIdx)] = operationIdx;
+        ++numCollapsedReshapes;
+    }
+
+    if (numCollapsedReshapes > 0)
+    {
+        ALOGV("ModelToINetworkConverter::CollapseReshapes(): %u reshape(s) merged into the following operation",
+            numCollapsedReshapes);
+    }
+}
+
+uint32_t ModelToINetworkConverter::AddOperandValues(const void* data, uint32_t numBytes)
+{
+    // Must only be used before any ConstTensorPin is created, as it can move the existing operand values
+    const uint32_t offset = (m_OperandValues.size() + 3u) & ~3u; // keep float data aligned
+    m_OperandValues.resize(offset);
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    m_OperandValues.insert(m_OperandValues.end(), bytes, bytes + numBytes);
+
+    return offset;
+}
+
+bool ModelToINetworkConverter::ConvertOperation(const V1_0::Operation& operation)
+{
+    switch (operation.type)
+    {
+        case V1_0::OperationType::ADD: return ConvertAdd(operation);
+        case V1_0::OperationType::AVERAGE_POOL_2D: return ConvertAveragePool2d(operation);
+        case V1_0::OperationType::CONCATENATION: return ConvertConcatenation(operation);
+        case V1_0::OperationType::CONV_2D: return ConvertConv2d(operation);
+        case V1_0::OperationType::DEPTHWISE_CONV_2D: return ConvertDepthwiseConv2d(operation);
+        case V1_0::OperationType::FLOOR: return ConvertFloor(operation);
+        case V1_0::OperationType::FULLY_CONNECTED: return ConvertFullyConnected(operation);
+        case V1_0::OperationType::LOCAL_RESPONSE_NORMALIZATION: return ConvertLocalResponseNormalization(operation);
+        case V1_0::OperationType::LOGISTIC: return ConvertLogistic(operation);
+        case V1_0::OperationType::L2_NORMALIZATION: return ConvertL2Normalization(operation);
+        case V1_0::OperationType::L2_POOL_2D: return ConvertL2Pool2d(operation);
+        case V1_0::OperationType::LSTM: return ConvertLstm(operation);
+        case V1_0::OperationType::MAX_POOL_2D: return ConvertMaxPool2d(operation);
+        case V1_0::OperationType::MUL: return ConvertMul(operation);
+        case V1_0::OperationType::RELU: return ConvertReLu(operation);
+        case V1_0::OperationType::RELU1: return ConvertReLu1(operation);
+        case V1_0::OperationType::RELU6: return ConvertReLu6(operation);
+        case V1_0::OperationType::SOFTMAX: return ConvertSoftmax(operation);
+        case V1_0::OperationType::TANH: return ConvertTanH(operation);
         case V1_0::OperationType::RESHAPE: return ConvertReshape(operation);
         case V1_0::OperationType::RESIZE_BILINEAR: return ConvertResizeBilinear(operation);
         default: return Fail("%s: Operation type %s not supported in ArmnnDriver",
@@ -503,8 +1682,13 @@ bool ModelToINetworkConverter::ConvertOperation(const V1_0::Operation& operation
 
 bool ModelToINetworkConverter::ConvertAdd(const V1_0::Operation& operation)
 {
-    LayerInputHandle input0 = ConvertToLayerInputHandle(operation, 0);
-    LayerInputHandle input1 = ConvertToLayerInputHandle(operation, 1);
+    // The addition is independent of the layout, so use whichever avoids the most permute layers
+    const bool useSwizzledInputs = ShouldUseSwizzledInputs(operation, 2);
+
+    LayerInputHandle input0 = useSwizzledInputs ? ConvertToSwizzledLayerInputHandle(operation, 0)
+                                                : ConvertToLayerInputHandle(operation, 0);
+    LayerInputHandle input1 = useSwizzledInputs ? ConvertToSwizzledLayerInputHandle(operation, 1)
+                                                : ConvertToLayerInputHandle(operation, 1);
 
     if (!input0.IsValid() || !input1.IsValid())
     {
@@ -523,11 +1707,34 @@ bool ModelToINetworkConverter::ConvertAdd(const V1_0::Operation& operation)
         return false;
     }
 
-    const armnn::TensorInfo outInfo = GetTensorInfoForOperand(*outputOperand);
+    if (!ValidateBroadcast(m_Model, operation, 2u))
+    {
+        return Fail("%s is invalid due to broadcasting", __func__);
+    }
+
+    armnn::TensorInfo outInfo = GetTensorInfoForOperand(*outputOperand);
+    if (useSwizzledInputs)
+    {
+        outInfo = armnnUtils::Permuted(outInfo, NHWCToArmNN);
+    }
+
+    // Quantized inputs are rescaled to the output's quantization space by the addition itself
+    if (input0.GetTensorInfo().GetDataType() != outInfo.GetDataType() ||
+        input1.GetTensorInfo().GetDataType() != outInfo.GetDataType())
+    {
+        return Fail("%s: Inputs and output must have the same data type", __func__);
+    }
+
+    // ArmNN's addition broadcasts dimensions of size 1 itself, once the inputs have the same rank
+    if (!ExpandToRank(input0, outInfo.GetNumDimensions()) || !ExpandToRank(input1, outInfo.GetNumDimensions()))
+    {
+        return false;
+    }
 
     if (!IsLayerSupported(__func__,
                           armnn::IsAdditionSupported,
-                          m_Compute,
+                          m_Backends,
+                          m_OperationBackendIndex,
                           input0.GetTensorInfo(),
                           input1.GetTensorInfo(),
                           outInfo))
@@ -538,55 +1745,13 @@ bool ModelToINetworkConverter::ConvertAdd(const V1_0::Operation& operation)
     armnn::IConnectableLayer* const startLayer = m_Network->AddAdditionLayer();
     armnn::IConnectableLayer* const endLayer = ProcessActivation(outInfo, activationFunction, startLayer);
 
-    const armnn::TensorInfo& inputTensorInfo0 = input0.GetTensorInfo();
-    const armnn::TensorInfo& inputTensorInfo1 = input1.GetTensorInfo();
-
     if (endLayer != nullptr)
     {
-        // If the number of dimensions do not match then we need to add degenerate dimensions
-        // to the "smaller" tensor using a reshape:
-        //   Small  Big
-        //     |     |
-        //  Reshape  |
-        //      \   /
-        //       Add
-        if (inputTensorInfo0.GetNumDimensions() != inputTensorInfo1.GetNumDimensions())
-        {
-            bool input0IsBigger = inputTensorInfo0.GetNumDimensions() > inputTensorInfo1.GetNumDimensions();
-
-            LayerInputHandle& smallTensorHandle = input0IsBigger ? input1 : input0;
-            const armnn::TensorInfo& smallTensorDims = smallTensorHandle.GetTensorInfo();
-
-            LayerInputHandle& bigTensorHandle =  input0IsBigger ? input0 : input1;
-            const armnn::TensorInfo& bigTensorDims = bigTensorHandle.GetTensorInfo();
-
-            std::vector<unsigned int> reshapedDims(bigTensorDims.GetNumDimensions(), 1);
-            unsigned int sizeDifference = bigTensorDims.GetNumDimensions() - smallTensorDims.GetNumDimensions();
-            for (unsigned i = sizeDifference; i < bigTensorDims.GetNumDimensions(); ++i)
-            {
-                reshapedDims[i] = smallTensorDims.GetShape()[i-sizeDifference];
-            }
-            armnn::TensorInfo reshapedInfo = smallTensorDims;
-            reshapedInfo.SetShape(armnn::TensorShape{ static_cast<unsigned int>(reshapedDims.size()),
-                                                      reshapedDims.data() });
-
-            armnn::ReshapeDescriptor reshapeDesc;
-            reshapeDesc.m_TargetShape = reshapedInfo.GetShape();
-            armnn::IConnectableLayer* const reshapeLayer = m_Network->AddReshapeLayer(reshapeDesc);
-            smallTensorHandle.Connect(reshapeLayer->GetInputSlot(0));
-            reshapeLayer->GetOutputSlot(0).SetTensorInfo(reshapedInfo);
-
-            // Connect the outputs from new reshape and original input layer
-            reshapeLayer->GetOutputSlot(0).Connect(startLayer->GetInputSlot(0));
-            bigTensorHandle.Connect(startLayer->GetInputSlot(1));
-        }
-        else
-        {
-            input0.Connect(startLayer->GetInputSlot(0));
-            input1.Connect(startLayer->GetInputSlot(1));
-        }
+        input0.Connect(startLayer->GetInputSlot(0));
+        input1.Connect(startLayer->GetInputSlot(1));
 
-        return SetupAndTrackLayerOutputSlot(operation, 0, *endLayer);
+        return useSwizzledInputs ? SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *endLayer)
+                                 : SetupAndTrackLayerOutputSlot(operation, 0, *endLayer);
     }
     else
     {
@@ -640,127 +1805,544 @@ bool ModelToINetworkConverter::ConvertConcatenation(const V1_0::Operation& opera
         return Fail("%s: Operation has invalid concat axis: %d", __func__, concatDim);
     }
 
-    // ArmNN uses Compute Library subtensors to perform concatenation
-    // This only works when concatenating along dimension 0 or 1 for a 4-D tensor,
+    // ArmNN uses Compute Library subtensors to perform concatenation, writing each input straight into its
+    // part of the output. This only works when concatenating along dimension 0 or 1 for a 4-D tensor,
     // or along dimension 0 for a 3-D tensor.
-    const armnn::PermutationVector* permuteVectorIn = &IdentityPermutation;
-    const armnn::PermutationVector* permuteVectorOut = &IdentityPermutation;
+    // Concatenation along the channel dimension is done in the ArmNN layout (where it becomes dimension 1)
+    // when the inputs are already available in that layout, as is concatenation along the batch dimension.
+    // Any other concatenation is done on 4-D views of the tensors in which the concatenation axis is
+    // dimension 1 (see GetConcatViewShape), so no layout conversions are needed for any rank or axis.
+    const unsigned int rank = outputShape.GetNumDimensions();
+    bool useSwizzledInputs = false;
+    bool useViews = false;
+
+    if (rank == 4 && (concatDim == 0 || concatDim == 3))
+    {
+        useSwizzledInputs = ShouldUseSwizzledInputs(operation, numInputTensors);
+        if (useSwizzledInputs)
+        {
+            concatDim = concatDim == 3 ? 1 : 0;
+            outputShape = armnnUtils::Permuted(outputShape, NHWCToArmNN);
+            outputInfo.SetShape(outputShape);
+        }
+        else
+        {
+            useViews = concatDim == 3;
+        }
+    }
+    else if (!(rank == 4 && concatDim == 1) && !(rank == 3 && concatDim == 0))
+    {
+        useViews = true;
+    }
 
-    assert(permuteVectorOut != nullptr);
+    std::vector<LayerInputHandle> inputHandles;
+    std::vector<armnn::TensorShape> inputShapes;
 
-    if (outputShape.GetNumDimensions() == 4) {
-        if (concatDim == 3) {
-            concatDim = 1;
-            permuteVectorIn = &NHWCToArmNN;
-            permuteVectorOut = &ArmNNToNHWC;
-            outputShape = armnnUtils::Permuted(outputShape, *permuteVectorIn);
-            outputInfo.SetShape(outputShape);
-        } else if (concatDim == 2) {
-            concatDim = 1;
-            permuteVectorIn = &SwapDim1And2;
-            permuteVectorOut = &SwapDim1And2;
-            outputShape = armnnUtils::Permuted(outputShape, *permuteVectorIn);
-            outputInfo.SetShape(outputShape);
+    inputHandles.reserve(numInputTensors);
+    inputShapes.reserve(numInputTensors);
+
+    for (uint32_t i = 0; i < numInputTensors; ++i)
+    {
+        const Operand* const operand = GetInputOperand(operation, i);
+        if (!operand)
+        {
+            return Fail("%s: Operation has invalid inputs", __func__);
+        }
+
+        // The merger may place its inputs in sub-tensors of its output, so a constant used more than once
+        // needs a separate layer for each use
+        const bool repeatedInput = std::find(operation.inputs.begin(), operation.inputs.begin() + i,
+                                             operation.inputs[i]) != operation.inputs.begin() + i;
+        if (repeatedInput && IsOperandConstant(*operand))
+        {
+            inputHandles.emplace_back(ConvertToConstLayerInputHandle(*operand, operation.inputs[i],
+                                                                     useSwizzledInputs, false));
+        }
+        else
+        {
+            inputHandles.emplace_back(useSwizzledInputs ? ConvertToSwizzledLayerInputHandle(operation, i)
+                                                        : ConvertToLayerInputHandle(operation, i));
+        }
+
+        if (!inputHandles.back().IsValid())
+        {
+            return Fail("%s: Operation has invalid inputs", __func__);
+        }
+
+        inputShapes.emplace_back(inputHandles.back().GetTensorInfo().GetShape());
+    }
+
+    assert(inputShapes.size() == inputHandles.size());
+
+    // The merger copies its inputs into the output unchanged, so quantized inputs must already be in
+    // the quantization space of the output
+    for (LayerInputHandle& inputHandle : inputHandles)
+    {
+        if (inputHandle.GetTensorInfo().GetDataType() != outputInfo.GetDataType())
+        {
+            return Fail("%s: Inputs and output have mismatched data types", __func__);
+        }
+        if (!RequantizeLayerInput(inputHandle, outputInfo))
+        {
+            return false;
+        }
+    }
+
+    if (useViews)
+    {
+        // Different shapes can have the same view, so the shapes are validated before reshaping to it
+        for (const armnn::TensorShape& inputShape : inputShapes)
+        {
+            if (inputShape.GetNumDimensions() != rank)
+            {
+                return Fail("%s: Inputs have mismatched ranks", __func__);
+            }
+            for (unsigned int d = 0; d < rank; ++d)
+            {
+                if (d != static_cast<unsigned int>(concatDim) && inputShape[d] != outputShape[d])
+                {
+                    return Fail("%s: Inputs have mismatched dimensions", __func__);
+                }
+            }
+        }
+        if (!ValidateConcatOutputShape(inputShapes, outputShape, concatDim))
+        {
+            return Fail("%s: Error validating the output shape for concat", __func__);
+        }
+
+        for (unsigned int i = 0; i < inputHandles.size(); ++i)
+        {
+            if (!ReshapeToConcatView(inputHandles[i], static_cast<uint32_t>(concatDim)))
+            {
+                return false;
+            }
+            inputShapes[i] = inputHandles[i].GetTensorInfo().GetShape();
+        }
+
+        outputShape = GetConcatViewShape(outputShape, static_cast<uint32_t>(concatDim));
+        outputInfo.SetShape(outputShape);
+        concatDim = 1;
+    }
+
+    // Create an armnn merger layer descriptor - this will also perform validation on the input shapes
+    armnn::OriginsDescriptor mergerDescriptor;
+    try
+    {
+        // The merger descriptor is always created across the only supported concat
+        // dimension, which is 0 or 1
+        mergerDescriptor =
+            armnn::CreateMergerDescriptorForConcatenation(
+                inputShapes.begin(), inputShapes.end(), concatDim);
+    }
+    catch (const armnn::Exception& error)
+    {
+        return Fail("%s: Error preparing merger descriptor. %s", __func__, error.what());
+    }
+
+    // Validate the output shape is correct given the input shapes based on the
+    // only valid concat dimension which is 0 or 1
+    if (!ValidateConcatOutputShape(inputShapes, outputShape, concatDim))
+    {
+        return Fail("%s: Error validating the output shape for concat", __func__);
+    }
+
+    std::vector<const armnn::TensorInfo*> inputTensorInfos;
+    std::transform(inputHandles.begin(), inputHandles.end(), std::back_inserter(inputTensorInfos),
+        [](const LayerInputHandle& h) -> const armnn::TensorInfo*{ return &h.GetTensorInfo(); });
+    if (!IsLayerSupported(__func__,
+                          armnn::IsMergerSupported,
+                          m_Backends,
+                          m_OperationBackendIndex,
+                          inputTensorInfos,
+                          mergerDescriptor))
+    {
+        return false;
+    }
+
+    armnn::IConnectableLayer* layer = m_Network->AddMergerLayer(mergerDescriptor);
+    assert(layer != nullptr);
+    layer->GetOutputSlot(0).SetTensorInfo(outputInfo);
+
+    // Connect inputs to the layer
+    const int numInputSlots = layer->GetNumInputSlots();
+    assert(static_cast<std::size_t>(numInputSlots) == inputHandles.size());
+    for (int i = 0; i < numInputSlots; ++i)
+    {
+        // connect the input directly to the merge (concat) layer
+        inputHandles[static_cast<unsigned int>(i)].Connect(layer->GetInputSlot(i));
+    }
+
+    if (useViews)
+    {
+        // Reshape the view of the output back to the output shape, unless they are the same
+        const armnn::TensorInfo finalOutputInfo = GetTensorInfoForOperand(*outputOperand);
+        if (finalOutputInfo.GetShape() != outputShape)
+        {
+            if (!IsLayerSupported(__func__,
+                                  armnn::IsReshapeSupported,
+                                  m_Backends,
+                                  m_OperationBackendIndex,
+                                  outputInfo))
+            {
+                return false;
+            }
+
+            armnn::ReshapeDescriptor reshapeDescriptor;
+            reshapeDescriptor.m_TargetShape = finalOutputInfo.GetShape();
+            armnn::IConnectableLayer* const reshapeLayer = m_Network->AddReshapeLayer(reshapeDescriptor);
+            assert(reshapeLayer != nullptr);
+            layer->GetOutputSlot(0).Connect(reshapeLayer->GetInputSlot(0));
+            layer = reshapeLayer;
         }
     }
-    else if (!(outputShape.GetNumDimensions() == 3 && concatDim == 0))
+
+    return useSwizzledInputs ? SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *layer)
+                             : SetupAndTrackLayerOutputSlot(operation, 0, *layer);
+}
+
+bool ModelToINetworkConverter::RequantizeLayerInput(LayerInputHandle& input, const armnn::TensorInfo& targetInfo)
+{
+    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
+    if (inputInfo.GetDataType() != armnn::DataType::QuantisedAsymm8 ||
+        (inputInfo.GetQuantizationScale() == targetInfo.GetQuantizationScale() &&
+         inputInfo.GetQuantizationOffset() == targetInfo.GetQuantizationOffset()))
+    {
+        return true;
+    }
+
+    // ArmNN has no requantize layer, but quantized activations dequantize their input and quantize their
+    // output with the quantization parameters of each. A bounded ReLu clamping to the range representable
+    // in the target space is therefore a saturating requantize.
+    const float targetScale = targetInfo.GetQuantizationScale();
+    const int32_t targetOffset = targetInfo.GetQuantizationOffset();
+
+    armnn::ActivationDescriptor requantizeDesc;
+    requantizeDesc.m_Function = armnn::ActivationFunction::BoundedReLu;
+    requantizeDesc.m_A = targetScale * static_cast<float>(std::numeric_limits<uint8_t>::max() - targetOffset);
+    requantizeDesc.m_B = targetScale * static_cast<float>(std::numeric_limits<uint8_t>::min() - targetOffset);
+
+    if (!IsLayerSupported(__func__, armnn::IsActivationSupported, m_Backends, m_OperationBackendIndex,
+                          inputInfo, requantizeDesc))
+    {
+        return false;
+    }
+
+    armnn::TensorInfo requantizedInfo = inputInfo;
+    requantizedInfo.SetQuantizationScale(targetScale);
+    requantizedInfo.SetQuantizationOffset(targetOffset);
+
+    armnn::IConnectableLayer* const requantizeLayer = m_Network->AddActivationLayer(requantizeDesc);
+    assert(requantizeLayer != nullptr);
+    input.Connect(requantizeLayer->GetInputSlot(0));
+    requantizeLayer->GetOutputSlot(0).SetTensorInfo(requantizedInfo);
+
+    ALOGV("%s: Requantizing from (%f, %d) to (%f, %d)", __func__, inputInfo.GetQuantizationScale(),
+          inputInfo.GetQuantizationOffset(), targetScale, targetOffset);
+
+    input = LayerInputHandle(true, &requantizeLayer->GetOutputSlot(0), requantizedInfo);
+    return true;
+}
+
+bool ModelToINetworkConverter::ReshapeToConcatView(LayerInputHandle& input, uint32_t concatAxis)
+{
+    armnn::TensorInfo viewInfo = input.GetTensorInfo();
+    viewInfo.SetShape(GetConcatViewShape(viewInfo.GetShape(), concatAxis));
+    if (viewInfo.GetShape() == input.GetTensorInfo().GetShape())
+    {
+        return true;
+    }
+
+    if (!IsLayerSupported(__func__,
+                          armnn::IsReshapeSupported,
+                          m_Backends,
+                          m_OperationBackendIndex,
+                          input.GetTensorInfo()))
+    {
+        return false;
+    }
+
+    armnn::ReshapeDescriptor reshapeDescriptor;
+    reshapeDescriptor.m_TargetShape = viewInfo.GetShape();
+    armnn::IConnectableLayer* const reshapeLayer = m_Network->AddReshapeLayer(reshapeDescriptor);
+    assert(reshapeLayer != nullptr);
+    input.Connect(reshapeLayer->GetInputSlot(0));
+    reshapeLayer->GetOutputSlot(0).SetTensorInfo(viewInfo);
+
+    input = LayerInputHandle(true, &reshapeLayer->GetOutputSlot(0), viewInfo);
+    return true;
+}
+
+bool ModelToINetworkConverter::ExpandToRank(LayerInputHandle& input, unsigned int rank)
+{
+    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
+    const unsigned int inputRank = inputInfo.GetNumDimensions();
+    if (inputRank >= rank)
+    {
+        return true;
+    }
+
+    // Broadcasting aligns the last dimensions, so the missing ones are leading dimensions of size 1
+    std::vector<unsigned int> expandedDims(rank, 1);
+    for (unsigned int d = 0; d < inputRank; ++d)
+    {
+        expandedDims[rank - inputRank + d] = inputInfo.GetShape()[d];
+    }
+    armnn::TensorInfo expandedInfo = inputInfo;
+    expandedInfo.SetShape(armnn::TensorShape(rank, expandedDims.data()));
+
+    if (!IsLayerSupported(__func__,
+                          armnn::IsReshapeSupported,
+                          m_Backends,
+                          m_OperationBackendIndex,
+                          inputInfo))
+    {
+        return false;
+    }
+
+    armnn::ReshapeDescriptor reshapeDescriptor;
+    reshapeDescriptor.m_TargetShape = expandedInfo.GetShape();
+    armnn::IConnectableLayer* const reshapeLayer = m_Network->AddReshapeLayer(reshapeDescriptor);
+    assert(reshapeLayer != nullptr);
+    input.Connect(reshapeLayer->GetInputSlot(0));
+    reshapeLayer->GetOutputSlot(0).SetTensorInfo(expandedInfo);
+
+    input = LayerInputHandle(true, &reshapeLayer->GetOutputSlot(0), expandedInfo);
+    return true;
+}
+
+bool ModelToINetworkConverter::BroadcastLayerInput(LayerInputHandle& input, const armnn::TensorShape& shape)
+{
+    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
+    if (inputInfo.GetShape() == shape)
+    {
+        return true;
+    }
+
+    // ArmNN has no broadcast layer, but its addition broadcasts dimensions of size 1, so the input is replicated
+    // by adding zero (in its own quantization space) of the full shape to it
+    armnn::TensorInfo broadcastInfo = inputInfo;
+    broadcastInfo.SetShape(shape);
+
+    if (!IsLayerSupported(__func__,
+                          armnn::IsAdditionSupported,
+                          m_Backends,
+                          m_OperationBackendIndex,
+                          inputInfo,
+                          broadcastInfo,
+                          broadcastInfo))
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> zeroData(broadcastInfo.GetNumBytes(), 0);
+    if (broadcastInfo.GetDataType() == armnn::DataType::QuantisedAsymm8)
+    {
+        std::fill(zeroData.begin(), zeroData.end(), static_cast<uint8_t>(broadcastInfo.GetQuantizationOffset()));
+    }
+
+    // The constant layer takes a copy of the data
+    armnn::IConnectableLayer* const zeroLayer =
+        m_Network->AddConstantLayer(armnn::ConstTensor(broadcastInfo, zeroData.data()));
+    assert(zeroLayer != nullptr);
+    zeroLayer->GetOutputSlot(0).SetTensorInfo(broadcastInfo);
+
+    armnn::IConnectableLayer* const broadcastLayer = m_Network->AddAdditionLayer();
+    assert(broadcastLayer != nullptr);
+    input.Connect(broadcastLayer->GetInputSlot(0));
+    zeroLayer->GetOutputSlot(0).Connect(broadcastLayer->GetInputSlot(1));
+    broadcastLayer->GetOutputSlot(0).SetTensorInfo(broadcastInfo);
+
+    input = LayerInputHandle(true, &broadcastLayer->GetOutputSlot(0), broadcastInfo);
+    return true;
+}
+
+bool ModelToINetworkConverter::IsChannelReplicationSupported(const armnn::TensorInfo& inputInfo,
+    unsigned int numReplicas, size_t& backendIndex) const
+{
+    // The input is split into its channels (unless it has only one), and each is concatenated numReplicas times
+    const armnn::TensorShape& inputShape = inputInfo.GetShape();
+    const unsigned int numChannels = inputShape[1];
+    if (numChannels > 1 &&
+        !IsLayerSupported(__func__,
+                          armnn::IsSplitterSupported,
+                          m_Backends,
+                          backendIndex,
+                          inputInfo,
+                          CreateChannelSplitterDescriptor(inputShape)))
     {
-        // Operation unsupported
         return false;
     }
 
-    std::vector<LayerInputHandle> inputHandles;
-    std::vector<armnn::TensorShape> inputShapes;
+    armnn::TensorInfo channelInfo = inputInfo;
+    channelInfo.SetShape(GetChannelShape(inputShape));
+    const std::vector<armnn::TensorShape> channelShapes(numChannels * numReplicas, channelInfo.GetShape());
+    const std::vector<const armnn::TensorInfo*> channelInfos(channelShapes.size(), &channelInfo);
+    return IsLayerSupported(__func__,
+                            armnn::IsMergerSupported,
+                            m_Backends,
+                            backendIndex,
+                            channelInfos,
+                            armnn::CreateMergerDescriptorForConcatenation(channelShapes.begin(),
+                                                                          channelShapes.end(), 1));
+}
 
-    inputHandles.reserve(numInputTensors);
-    inputShapes.reserve(numInputTensors);
+void ModelToINetworkConverter::ReplicateChannels(LayerInputHandle& input, unsigned int numReplicas)
+{
+    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
+    const armnn::TensorShape& inputShape = inputInfo.GetShape();
+    const unsigned int numChannels = inputShape[1];
 
-    for (uint32_t i = 0; i < numInputTensors; ++i)
+    armnn::TensorInfo channelInfo = inputInfo;
+    channelInfo.SetShape(GetChannelShape(inputShape));
+    const std::vector<armnn::TensorShape> channelShapes(numChannels * numReplicas, channelInfo.GetShape());
+    armnn::IConnectableLayer* const mergerLayer = m_Network->AddMergerLayer(
+        armnn::CreateMergerDescriptorForConcatenation(channelShapes.begin(), channelShapes.end(), 1));
+    assert(mergerLayer != nullptr);
+
+    if (numChannels > 1)
     {
-        const Operand* const operand = GetInputOperand(operation, i);
-        if (!operand)
+        armnn::IConnectableLayer* const splitterLayer =
+            m_Network->AddSplitterLayer(CreateChannelSplitterDescriptor(inputShape));
+        assert(splitterLayer != nullptr);
+        input.Connect(splitterLayer->GetInputSlot(0));
+
+        for (unsigned int c = 0; c < numChannels; ++c)
         {
-            return Fail("%s: Operation has invalid inputs", __func__);
+            splitterLayer->GetOutputSlot(c).SetTensorInfo(channelInfo);
+            for (unsigned int r = 0; r < numReplicas; ++r)
+            {
+                splitterLayer->GetOutputSlot(c).Connect(mergerLayer->GetInputSlot(c * numReplicas + r));
+            }
         }
-
-        inputShapes.emplace_back(GetTensorShapeForOperand(*operand));
-        inputHandles.emplace_back(ConvertToLayerInputHandle(operation, i));
-
-
-        if (!inputHandles.back().IsValid())
+    }
+    else
+    {
+        for (unsigned int r = 0; r < numReplicas; ++r)
         {
-            return Fail("%s: Operation has invalid inputs", __func__);
+            input.Connect(mergerLayer->GetInputSlot(r));
         }
     }
 
-    assert(inputShapes.size() == inputHandles.size());
+    const armnn::TensorInfo replicatedInfo = GetReplicatedChannelsInfo(inputInfo, numReplicas);
+    mergerLayer->GetOutputSlot(0).SetTensorInfo(replicatedInfo);
+    input = LayerInputHandle(true, &mergerLayer->GetOutputSlot(0), replicatedInfo);
+}
 
-    // this is no-op for identity swizzles, otherwise it replaces both
-    // the handles and shapes with the swizzled layer output handles and shapes
-    SwizzleInputs(*m_Network, inputHandles, inputShapes, *permuteVectorIn);
+bool ModelToINetworkConverter::IsDepthwiseAsGroupedConvolutionSupported(const armnn::TensorInfo& inputInfo,
+    const armnn::TensorInfo& outputInfo, const armnn::DepthwiseConvolution2dDescriptor& desc,
+    const armnn::ConstTensor& weights, const armnn::ConstTensor& bias, size_t& backendIndex) const
+{
+    const std::vector<DepthwiseConvolutionGroup> groups =
+        GetDepthwiseConvolutionGroups(inputInfo, outputInfo, weights, bias);
+    const armnn::Convolution2dDescriptor convDesc = GetConvolutionDescriptor(desc);
 
-    // Create an armnn merger layer descriptor - this will also perform validation on the input shapes
-    armnn::OriginsDescriptor mergerDescriptor;
-    try
+    for (const DepthwiseConvolutionGroup& group : groups)
     {
-        // The merger descriptor is always created across the only supported concat
-        // dimension, which is 0 or 1
-        mergerDescriptor =
-            armnn::CreateMergerDescriptorForConcatenation(
-                inputShapes.begin(), inputShapes.end(), concatDim);
+        if (!IsLayerSupported(__func__,
+                              armnn::IsConvolution2dSupported,
+                              m_Backends,
+                              backendIndex,
+                              group.m_InputInfo,
+                              group.m_OutputInfo,
+                              convDesc,
+                              group.m_WeightsInfo,
+                              group.m_BiasInfo))
+        {
+            return false;
+        }
     }
-    catch (const armnn::Exception& error)
+
+    if (groups.size() == 1)
     {
-        return Fail("%s: Error preparing merger descriptor. %s", __func__, error.what());
+        return true;
     }
 
-    // Validate the output shape is correct given the input shapes based on the
-    // only valid concat dimension which is 0 or 1
-    if (!ValidateConcatOutputShape(inputShapes, outputShape, concatDim))
+    std::vector<armnn::TensorShape> outputShapes;
+    std::vector<const armnn::TensorInfo*> outputInfos;
+    for (const DepthwiseConvolutionGroup& group : groups)
+    {
+        outputShapes.push_back(group.m_OutputInfo.GetShape());
+        outputInfos.push_back(&group.m_OutputInfo);
+    }
+
+    const armnn::ViewsDescriptor splitterDesc =
+        CreateChannelSplitterDescriptor(inputInfo.GetShape(), g_DepthwiseConvolutionGroupChannels);
+    return IsLayerSupported(__func__,
+                            armnn::IsSplitterSupported,
+                            m_Backends,
+                            backendIndex,
+                            inputInfo,
+                            splitterDesc) &&
+           IsLayerSupported(__func__,
+                            armnn::IsMergerSupported,
+                            m_Backends,
+                            backendIndex,
+                            outputInfos,
+                            armnn::CreateMergerDescriptorForConcatenation(outputShapes.begin(),
+                                                                          outputShapes.end(), 1));
+}
+
+armnn::IConnectableLayer* ModelToINetworkConverter::AddDepthwiseAsGroupedConvolution(LayerInputHandle& input,
+    const armnn::TensorInfo& outputInfo, const armnn::DepthwiseConvolution2dDescriptor& desc,
+    const armnn::ConstTensor& weights, const armnn::ConstTensor& bias)
+{
+    const std::vector<DepthwiseConvolutionGroup> groups =
+        GetDepthwiseConvolutionGroups(input.GetTensorInfo(), outputInfo, weights, bias);
+    const armnn::Convolution2dDescriptor convDesc = GetConvolutionDescriptor(desc);
+    const unsigned int depthMultiplier = weights.GetShape()[0];
+    const size_t biasElementSize = armnn::GetDataTypeSize(bias.GetDataType());
+
+    // The convolution layers take copies of the weights and bias
+    std::vector<armnn::IConnectableLayer*> convLayers;
+    for (const DepthwiseConvolutionGroup& group : groups)
     {
-        return Fail("%s: Error validating the output shape for concat", __func__);
+        const std::vector<uint8_t> denseWeights =
+            ExpandDepthwiseWeightsToDense(weights, group.m_FirstChannel, group.m_InputInfo.GetShape()[1]);
+        const uint8_t* groupBias = static_cast<const uint8_t*>(bias.GetMemoryArea()) +
+                                   group.m_FirstChannel * depthMultiplier * biasElementSize;
+
+        armnn::IConnectableLayer* const convLayer = m_Network->AddConvolution2dLayer(convDesc,
+            armnn::ConstTensor(group.m_WeightsInfo, denseWeights.data()),
+            armnn::ConstTensor(group.m_BiasInfo, groupBias));
+        assert(convLayer != nullptr);
+        convLayer->GetOutputSlot(0).SetTensorInfo(group.m_OutputInfo);
+        convLayers.push_back(convLayer);
     }
 
-    std::vector<const armnn::TensorInfo*> inputTensorInfos;
-    std::transform(inputHandles.begin(), inputHandles.end(), std::back_inserter(inputTensorInfos),
-        [](const LayerInputHandle& h) -> const armnn::TensorInfo*{ return &h.GetTensorInfo(); });
-    if (!IsLayerSupported(__func__,
-                          armnn::IsMergerSupported,
-                          m_Compute,
-                          inputTensorInfos,
-                          mergerDescriptor))
+    if (groups.size() == 1)
     {
-        return false;
+        input.Connect(convLayers[0]->GetInputSlot(0));
+        return convLayers[0];
     }
 
-    armnn::IConnectableLayer* layer = m_Network->AddMergerLayer(mergerDescriptor);
-    assert(layer != nullptr);
-    layer->GetOutputSlot(0).SetTensorInfo(outputInfo);
+    armnn::IConnectableLayer* const splitterLayer = m_Network->AddSplitterLayer(
+        CreateChannelSplitterDescriptor(input.GetTensorInfo().GetShape(), g_DepthwiseConvolutionGroupChannels));
+    assert(splitterLayer != nullptr);
+    input.Connect(splitterLayer->GetInputSlot(0));
 
-    // Connect inputs to the layer
-    const int numInputSlots = layer->GetNumInputSlots();
-    assert(static_cast<std::size_t>(numInputSlots) == inputHandles.size());
-    for (int i = 0; i < numInputSlots; ++i)
+    std::vector<armnn::TensorShape> outputShapes;
+    for (const DepthwiseConvolutionGroup& group : groups)
     {
-        // connect the input directly to the merge (concat) layer
-        inputHandles[static_cast<unsigned int>(i)].Connect(layer->GetInputSlot(i));
+        outputShapes.push_back(group.m_OutputInfo.GetShape());
     }
+    armnn::IConnectableLayer* const mergerLayer = m_Network->AddMergerLayer(
+        armnn::CreateMergerDescriptorForConcatenation(outputShapes.begin(), outputShapes.end(), 1));
+    assert(mergerLayer != nullptr);
+    mergerLayer->GetOutputSlot(0).SetTensorInfo(outputInfo);
 
-    if (permuteVectorOut != &IdentityPermutation)
+    for (unsigned int g = 0; g < groups.size(); ++g)
     {
-        // Add permutation layer and connect the output to it, the permutation becomes the output layer
-        armnn::IConnectableLayer& deswizzleLayer = AddPermuteLayer(*m_Network,
-                                                                   layer->GetOutputSlot(0),
-                                                                   *permuteVectorOut);
-        layer = &deswizzleLayer;
+        splitterLayer->GetOutputSlot(g).SetTensorInfo(groups[g].m_InputInfo);
+        splitterLayer->GetOutputSlot(g).Connect(convLayers[g]->GetInputSlot(0));
+        convLayers[g]->GetOutputSlot(0).Connect(mergerLayer->GetInputSlot(g));
     }
 
-    return SetupAndTrackLayerOutputSlot(operation, 0, *layer);
+    return mergerLayer;
 }
 
 bool ModelToINetworkConverter::ConvertConv2d(const V1_0::Operation& operation)
 {
-    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    LayerInputHandle input = ConvertToSwizzledLayerInputHandle(operation, 0);
     if (!input.IsValid())
     {
         return Fail("%s: Operation has invalid inputs", __func__);
@@ -772,21 +2354,25 @@ bool ModelToINetworkConverter::ConvertConv2d(const V1_0::Operation& operation)
         return Fail("%s: Could not read output 0", __func__);
     }
 
-    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
-    const armnn::TensorInfo& outputInfo = GetTensorInfoForOperand(*output);
-
-    const armnn::TensorInfo swizzledInputInfo = armnnUtils::Permuted(inputInfo, NHWCToArmNN);
-    const armnn::TensorInfo swizzledOutputInfo = armnnUtils::Permuted(outputInfo, NHWCToArmNN);
+    const armnn::TensorInfo& swizzledInputInfo = input.GetTensorInfo();
+    const armnn::TensorInfo swizzledOutputInfo = GetSwizzledTensorInfoForOperand(*output);
 
     // ArmNN does not currently support non-fixed weights or bias
-    const ConstTensorPin weightsPin = ConvertOperationInputToConstTensorPin(operation, 1, NHWCToArmNN);
-    const ConstTensorPin biasPin = ConvertOperationInputToConstTensorPin(operation, 2);
+    ConstTensorPin weightsPin = ConvertOperationInputToConstTensorPin(operation, 1, NHWCToArmNN);
+    ConstTensorPin biasPin = ConvertOperationInputToConstTensorPin(operation, 2);
 
     if (!weightsPin.IsValid() || !biasPin.IsValid())
     {
         return Fail("%s: Operation has invalid inputs", __func__);
     }
 
+    // Weights are [ O, I, H, W ]
+    const unsigned int weightsPerOutputChannel =
+        weightsPin.GetConstTensor().GetNumElements() / weightsPin.GetConstTensor().GetShape()[0];
+    ApplyChannelAffineTransform(operation, weightsPin, biasPin,
+        [weightsPerOutputChannel](unsigned int i) { return i / weightsPerOutputChannel; });
+    LogWeightSparsity(__func__, weightsPin);
+
     armnn::ConstTensor weights = weightsPin.GetConstTensor();
     armnn::ConstTensor bias = biasPin.GetConstTensor();
     SanitizeBiasQuantizationScale(bias.GetInfo(), weights.GetInfo(), swizzledInputInfo);
@@ -836,7 +2422,8 @@ bool ModelToINetworkConverter::ConvertConv2d(const V1_0::Operation& operation)
 
     if (!IsLayerSupported(__func__,
                           armnn::IsConvolution2dSupported,
-                          m_Compute,
+                          m_Backends,
+                          m_OperationBackendIndex,
                           swizzledInputInfo,
                           swizzledOutputInfo,
                           desc,
@@ -851,8 +2438,8 @@ bool ModelToINetworkConverter::ConvertConv2d(const V1_0::Operation& operation)
 
     if (endLayer != nullptr)
     {
-        armnn::IConnectableLayer& outSwizzleLayer = SwizzleInDeswizzleOut(*m_Network, input, *startLayer, *endLayer);
-        return SetupAndTrackLayerOutputSlot(operation, 0, outSwizzleLayer);
+        input.Connect(startLayer->GetInputSlot(0));
+        return SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *endLayer);
     }
     else
     {
@@ -862,7 +2449,7 @@ bool ModelToINetworkConverter::ConvertConv2d(const V1_0::Operation& operation)
 
 bool ModelToINetworkConverter::ConvertDepthwiseConv2d(const V1_0::Operation& operation)
 {
-    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    LayerInputHandle input = ConvertToSwizzledLayerInputHandle(operation, 0);
     if (!input.IsValid())
     {
         return Fail("%s: Operation has invalid inputs", __func__);
@@ -874,11 +2461,8 @@ bool ModelToINetworkConverter::ConvertDepthwiseConv2d(const V1_0::Operation& ope
         return Fail("%s: Could not read output 0", __func__);
     }
 
-    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
-    const armnn::TensorInfo& outputInfo = GetTensorInfoForOperand(*output);
-
-    const armnn::TensorInfo swizzledInputInfo = armnnUtils::Permuted(inputInfo, NHWCToArmNN);
-    const armnn::TensorInfo swizzledOutputInfo = armnnUtils::Permuted(outputInfo, NHWCToArmNN);
+    const armnn::TensorInfo& swizzledInputInfo = input.GetTensorInfo();
+    const armnn::TensorInfo swizzledOutputInfo = GetSwizzledTensorInfoForOperand(*output);
 
     // ArmNN does not currently support non-fixed weights or bias
 
@@ -893,8 +2477,8 @@ bool ModelToINetworkConverter::ConvertDepthwiseConv2d(const V1_0::Operation& ope
 
     // Reinterpret weight data as [ H, W, I, M ]
     armnn::TensorShape weightsShape({ weightsOperand->dimensions[1], weightsOperand->dimensions[2],
-                                      inputInfo.GetShape()[3],
-                                      weightsOperand->dimensions[3] / inputInfo.GetShape()[3] });
+                                      swizzledInputInfo.GetShape()[1],
+                                      weightsOperand->dimensions[3] / swizzledInputInfo.GetShape()[1] });
 
     // Swizzle weight data [ H, W, I, M ] -> [ M, I, H, W ]
     const armnn::PermutationVector HWIMToMIHW = { 2U, 3U, 1U, 0U };
@@ -908,6 +2492,19 @@ bool ModelToINetworkConverter::ConvertDepthwiseConv2d(const V1_0::Operation& ope
         return Fail("%s: Operation has invalid inputs", __func__);
     }
 
+    // Output channel i * M + m uses the weights at [ m, i, :, : ]
+    const unsigned int depthMultiplier = weightsShape[3];
+    const unsigned int numInputChannels = weightsShape[2];
+    const unsigned int kernelSize = weightsShape[0] * weightsShape[1];
+    ApplyChannelAffineTransform(operation, weightsPin, biasPin,
+        [=](unsigned int i)
+        {
+            const unsigned int m = i / (numInputChannels * kernelSize);
+            const unsigned int inputChannel = (i / kernelSize) % numInputChannels;
+            return inputChannel * depthMultiplier + m;
+        });
+    LogWeightSparsity(__func__, weightsPin);
+
     armnn::ConstTensor weights = weightsPin.GetConstTensor();
     armnn::ConstTensor bias = biasPin.GetConstTensor();
     SanitizeBiasQuantizationScale(bias.GetInfo(), weights.GetInfo(), swizzledInputInfo);
@@ -955,23 +2552,93 @@ bool ModelToINetworkConverter::ConvertDepthwiseConv2d(const V1_0::Operation& ope
 
     desc.m_BiasEnabled = true;
 
-    if (!IsLayerSupported(__func__,
-                          armnn::IsDepthwiseConvolutionSupported,
-                          m_Compute,
-                          swizzledInputInfo,
-                          desc,
-                          weights.GetInfo()))
+    // The convolution runs natively if possible. Otherwise, or if that needs a less preferred backend,
+    // two equivalent forms are tried, and the one needing the most preferred backend is used:
+    // - Backends which don't support a depth multiplier above 1 can run the convolution on an input in which each
+    //   channel is repeated M times, with a depth multiplier of 1 and the weights reordered to match.
+    // - Backends which don't support the kernel size (as for quantized depthwise convolutions other than 3x3) can
+    //   run it as ordinary convolutions of groups of channels, with dense weights which are zero between channels.
+    enum class DepthwiseStrategy { Native, ReplicatedChannels, GroupedConvolution };
+    DepthwiseStrategy strategy = DepthwiseStrategy::Native;
+
+    size_t bestBackendIndex = m_OperationBackendIndex;
+    bool isSupported = IsLayerSupported(__func__,
+                                        armnn::IsDepthwiseConvolutionSupported,
+                                        m_Backends,
+                                        bestBackendIndex,
+                                        swizzledInputInfo,
+                                        desc,
+                                        weights.GetInfo());
+
+    armnn::TensorInfo flattenedWeightsInfo = weights.GetInfo();
+    flattenedWeightsInfo.SetShape(armnn::TensorShape({ 1, numInputChannels * depthMultiplier,
+                                                       weights.GetShape()[2], weights.GetShape()[3] }));
+
+    size_t replicatedBackendIndex = m_OperationBackendIndex;
+    if (depthMultiplier > 1 && (!isSupported || bestBackendIndex > m_OperationBackendIndex) &&
+        IsChannelReplicationSupported(swizzledInputInfo, depthMultiplier, replicatedBackendIndex) &&
+        IsLayerSupported(__func__,
+                         armnn::IsDepthwiseConvolutionSupported,
+                         m_Backends,
+                         replicatedBackendIndex,
+                         GetReplicatedChannelsInfo(swizzledInputInfo, depthMultiplier),
+                         desc,
+                         flattenedWeightsInfo) &&
+        (!isSupported || replicatedBackendIndex < bestBackendIndex))
+    {
+        strategy = DepthwiseStrategy::ReplicatedChannels;
+        bestBackendIndex = replicatedBackendIndex;
+        isSupported = true;
+    }
+
+    size_t groupedBackendIndex = m_OperationBackendIndex;
+    if ((!isSupported || bestBackendIndex > m_OperationBackendIndex) &&
+        IsDepthwiseAsGroupedConvolutionSupported(swizzledInputInfo, swizzledOutputInfo, desc, weights, bias,
+                                                 groupedBackendIndex) &&
+        (!isSupported || groupedBackendIndex < bestBackendIndex))
+    {
+        strategy = DepthwiseStrategy::GroupedConvolution;
+        bestBackendIndex = groupedBackendIndex;
+        isSupported = true;
+    }
+
+    if (!isSupported)
     {
         return false;
     }
+    m_OperationBackendIndex = bestBackendIndex;
+
+    // Weights are rearranged once here, and copied by the layers using them
+    std::vector<uint8_t> flattenedWeightsData;
+    if (strategy == DepthwiseStrategy::ReplicatedChannels)
+    {
+        flattenedWeightsData = FlattenDepthMultiplier(weights);
+        weights = armnn::ConstTensor(flattenedWeightsInfo, flattenedWeightsData.data());
+    }
+
+    if (strategy == DepthwiseStrategy::GroupedConvolution)
+    {
+        armnn::IConnectableLayer* const groupedLayer =
+            AddDepthwiseAsGroupedConvolution(input, swizzledOutputInfo, desc, weights, bias);
+        armnn::IConnectableLayer* const endLayer = ProcessActivation(swizzledOutputInfo, activation, groupedLayer);
+        if (endLayer == nullptr)
+        {
+            return Fail("%s: ProcessActivation failed", __func__);
+        }
+        return SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *endLayer);
+    }
 
     armnn::IConnectableLayer* startLayer = m_Network->AddDepthwiseConvolution2dLayer(desc, weights, bias);
     armnn::IConnectableLayer* endLayer = ProcessActivation(swizzledOutputInfo, activation, startLayer);
 
     if (endLayer != nullptr)
     {
-        armnn::IConnectableLayer& outSwizzleLayer = SwizzleInDeswizzleOut(*m_Network, input, *startLayer, *endLayer);
-        return SetupAndTrackLayerOutputSlot(operation, 0, outSwizzleLayer);
+        if (strategy == DepthwiseStrategy::ReplicatedChannels)
+        {
+            ReplicateChannels(input, depthMultiplier);
+        }
+        input.Connect(startLayer->GetInputSlot(0));
+        return SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *endLayer);
     }
     else
     {
@@ -981,7 +2648,10 @@ bool ModelToINetworkConverter::ConvertDepthwiseConv2d(const V1_0::Operation& ope
 
 bool ModelToINetworkConverter::ConvertFloor(const V1_0::Operation& operation)
 {
-    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    const bool useSwizzledInputs = ShouldUseSwizzledInputs(operation, 1);
+
+    LayerInputHandle input = useSwizzledInputs ? ConvertToSwizzledLayerInputHandle(operation, 0)
+                                               : ConvertToLayerInputHandle(operation, 0);
     if (!input.IsValid())
     {
         return Fail("%s: Operation has invalid inputs", __func__);
@@ -993,11 +2663,18 @@ bool ModelToINetworkConverter::ConvertFloor(const V1_0::Operation& operation)
         return Fail("%s: Operation has invalid outputs", __func__);
     }
 
+    armnn::TensorInfo outputInfo = GetTensorInfoForOperand(*outputOperand);
+    if (useSwizzledInputs)
+    {
+        outputInfo = armnnUtils::Permuted(outputInfo, NHWCToArmNN);
+    }
+
     if (!IsLayerSupported(__func__,
                           armnn::IsFloorSupported,
-                          m_Compute,
+                          m_Backends,
+                          m_OperationBackendIndex,
                           input.GetTensorInfo(),
-                          GetTensorInfoForOperand(*outputOperand)))
+                          outputInfo))
     {
         return false;
     }
@@ -1006,12 +2683,13 @@ bool ModelToINetworkConverter::ConvertFloor(const V1_0::Operation& operation)
     assert(layer != nullptr);
     input.Connect(layer->GetInputSlot(0));
 
-    return SetupAndTrackLayerOutputSlot(operation, 0, *layer);
+    return useSwizzledInputs ? SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *layer)
+                             : SetupAndTrackLayerOutputSlot(operation, 0, *layer);
 }
 
 bool ModelToINetworkConverter::ConvertFullyConnected(const V1_0::Operation& operation)
 {
-    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    LayerInputHandle input = ConvertToLayerInputHandleForReshape(operation, 0);
     if (!input.IsValid())
     {
         return Fail("%s: Operation has invalid inputs", __func__);
@@ -1047,6 +2725,27 @@ bool ModelToINetworkConverter::ConvertFullyConnected(const V1_0::Operation& oper
         return Fail("%s: Operation has invalid inputs", __func__);
     }
 
+    const armnn::TensorInfo& weightsInfo = weightsPin.GetConstTensor().GetInfo();
+    if (weightsInfo.GetDataType() != reshapedInfo.GetDataType() || outputInfo.GetDataType() != reshapedInfo.GetDataType())
+    {
+        return Fail("%s: Input, weights and output must have the same data type", __func__);
+    }
+
+    // As required by AndroidNN, so that the rescaling of the accumulators to the output is a multiplier below 1
+    if (reshapedInfo.GetDataType() == armnn::DataType::QuantisedAsymm8 &&
+        !(outputInfo.GetQuantizationScale() > reshapedInfo.GetQuantizationScale() * weightsInfo.GetQuantizationScale()))
+    {
+        return Fail("%s: Output scale %f must be greater than the product of the input and weights scales (%f * %f)",
+            __func__, outputInfo.GetQuantizationScale(), reshapedInfo.GetQuantizationScale(),
+            weightsInfo.GetQuantizationScale());
+    }
+
+    // Weights are [ num units, input size ]
+    const unsigned int inputSize = weightsPin.GetConstTensor().GetShape()[1];
+    ApplyChannelAffineTransform(operation, weightsPin, biasPin,
+        [inputSize](unsigned int i) { return i / inputSize; });
+    LogWeightSparsity(__func__, weightsPin);
+
     // ensuring that the bias value is within 1% of the weights input (small float differences can exist)
     armnn::ConstTensor weights = weightsPin.GetConstTensor();
     armnn::ConstTensor bias = biasPin.GetConstTensor();
@@ -1064,7 +2763,8 @@ bool ModelToINetworkConverter::ConvertFullyConnected(const V1_0::Operation& oper
 
     if (!IsLayerSupported(__func__,
                           armnn::IsFullyConnectedSupported,
-                          m_Compute,
+                          m_Backends,
+                          m_OperationBackendIndex,
                           reshapedInfo,
                           desc))
     {
@@ -1102,7 +2802,7 @@ bool ModelToINetworkConverter::ConvertFullyConnected(const V1_0::Operation& oper
 
 bool ModelToINetworkConverter::ConvertLocalResponseNormalization(const V1_0::Operation& operation)
 {
-    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    LayerInputHandle input = ConvertToSwizzledLayerInputHandle(operation, 0);
     if (!input.IsValid())
     {
         return Fail("%s: Operation has invalid inputs", __func__);
@@ -1114,11 +2814,8 @@ bool ModelToINetworkConverter::ConvertLocalResponseNormalization(const V1_0::Ope
         return Fail("%s: Could not read output 0", __func__);
     }
 
-    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
-    const armnn::TensorInfo& outputInfo = GetTensorInfoForOperand(*output);
-
-    const armnn::TensorInfo swizzledInputInfo = armnnUtils::Permuted(inputInfo, NHWCToArmNN);
-    const armnn::TensorInfo swizzledOutputInfo = armnnUtils::Permuted(outputInfo, NHWCToArmNN);
+    const armnn::TensorInfo& swizzledInputInfo = input.GetTensorInfo();
+    const armnn::TensorInfo swizzledOutputInfo = GetSwizzledTensorInfoForOperand(*output);
 
     armnn::NormalizationDescriptor descriptor;
 
@@ -1140,7 +2837,8 @@ bool ModelToINetworkConverter::ConvertLocalResponseNormalization(const V1_0::Ope
 
     if (!IsLayerSupported(__func__,
                         armnn::IsNormalizationSupported,
-                        m_Compute,
+                        m_Backends,
+                        m_OperationBackendIndex,
                         swizzledInputInfo,
                         swizzledOutputInfo,
                         descriptor))
@@ -1153,9 +2851,9 @@ bool ModelToINetworkConverter::ConvertLocalResponseNormalization(const V1_0::Ope
     assert(layer != nullptr);
     layer->GetOutputSlot(0).SetTensorInfo(swizzledOutputInfo);
 
-    armnn::IConnectableLayer& outSwizzleLayer = SwizzleInDeswizzleOut(*m_Network, input, *layer);
+    input.Connect(layer->GetInputSlot(0));
 
-    return SetupAndTrackLayerOutputSlot(operation, 0, outSwizzleLayer);
+    return SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *layer);
 }
 
 bool ModelToINetworkConverter::ConvertLogistic(const V1_0::Operation& operation)
@@ -1168,7 +2866,7 @@ bool ModelToINetworkConverter::ConvertLogistic(const V1_0::Operation& operation)
 
 bool ModelToINetworkConverter::ConvertL2Normalization(const V1_0::Operation& operation)
 {
-    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    LayerInputHandle input = ConvertToSwizzledLayerInputHandle(operation, 0);
     if (!input.IsValid())
     {
         return Fail("%s: Operation has invalid inputs", __func__);
@@ -1180,15 +2878,13 @@ bool ModelToINetworkConverter::ConvertL2Normalization(const V1_0::Operation& ope
         return Fail("%s: Could not read output 0", __func__);
     }
 
-    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
-    const armnn::TensorInfo& outputInfo = GetTensorInfoForOperand(*output);
-
-    const armnn::TensorInfo swizzledInputInfo = armnnUtils::Permuted(inputInfo, NHWCToArmNN);
-    const armnn::TensorInfo swizzledOutputInfo = armnnUtils::Permuted(outputInfo, NHWCToArmNN);
+    const armnn::TensorInfo& swizzledInputInfo = input.GetTensorInfo();
+    const armnn::TensorInfo swizzledOutputInfo = GetSwizzledTensorInfoForOperand(*output);
 
     if (!IsLayerSupported(__func__,
                           armnn::IsL2NormalizationSupported,
-                          m_Compute,
+                          m_Backends,
+                          m_OperationBackendIndex,
                           swizzledInputInfo))
     {
         return false;
@@ -1198,14 +2894,442 @@ bool ModelToINetworkConverter::ConvertL2Normalization(const V1_0::Operation& ope
     assert(layer != nullptr);
     layer->GetOutputSlot(0).SetTensorInfo(swizzledOutputInfo);
 
-    armnn::IConnectableLayer& outSwizzleLayer = SwizzleInDeswizzleOut(*m_Network, input, *layer);
+    input.Connect(layer->GetInputSlot(0));
+
+    return SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *layer);
+}
 
-    return SetupAndTrackLayerOutputSlot(operation, 0, outSwizzleLayer);
+bool ModelToINetworkConverter::ConvertL2Pool2d(const V1_0::Operation& operation)
+{
+    return ConvertPooling2d(operation, __func__, armnn::PoolingAlgorithm::L2);
 }
 
-bool ModelToINetworkConverter::ConvertL2Pool2d(const V1_0::Operation& operation)
-{
-    return ConvertPooling2d(operation, __func__, armnn::PoolingAlgorithm::L2);
+bool ModelToINetworkConverter::ConvertLstm(const V1_0::Operation& operation)
+{
+    // Inputs:
+    // 00:    input [ batch size, input size ]
+    // 01-04: input to input, forget, cell and output gate weights [ num units, input size ]
+    // 05-08: recurrent to input, forget, cell and output gate weights [ num units, output size ]
+    // 09-11: cell to input, forget and output gate (peephole) weights [ num units ]
+    // 12-15: input, forget, cell and output gate biases [ num units ]
+    // 16-17: projection weights [ output size, num units ] and bias [ output size ]
+    // 18-19: output state in [ batch size, output size ] and cell state in [ batch size, num units ]
+    // 20-22: activation, cell clip and projection clip
+    // The input gate weights and bias are omitted with coupled input and forget gates (CIFG), and the peephole
+    // and projection inputs are optional.
+    // Outputs: scratch buffer, output state out, cell state out and output.
+    if (operation.inputs.size() != 23 || operation.outputs.size() != 4)
+    {
+        return Fail("%s: Unsupported number of operation inputs or outputs", __func__);
+    }
+
+    auto isOmitted = [&](uint32_t inputIndex)
+    {
+        const Operand* operand = GetInputOperand(operation, inputIndex);
+        return operand->lifetime == OperandLifeTime::NO_VALUE ||
+               std::find(operand->dimensions.begin(), operand->dimensions.end(), 0u) != operand->dimensions.end();
+    };
+    const bool useCifg = isOmitted(1);
+    const bool usePeephole = !isOmitted(10);
+    const bool useProjection = !isOmitted(16);
+
+    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    LayerInputHandle outputStateIn = ConvertToLayerInputHandle(operation, 18);
+    LayerInputHandle cellStateIn = ConvertToLayerInputHandle(operation, 19);
+    if (!input.IsValid() || !outputStateIn.IsValid() || !cellStateIn.IsValid())
+    {
+        return Fail("%s: Operation has invalid inputs", __func__);
+    }
+
+    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
+    const armnn::TensorInfo& cellStateInfo = cellStateIn.GetTensorInfo();
+    if (inputInfo.GetDataType() != armnn::DataType::Float32 || inputInfo.GetNumDimensions() != 2 ||
+        outputStateIn.GetTensorInfo().GetNumDimensions() != 2 || cellStateInfo.GetNumDimensions() != 2)
+    {
+        return Fail("%s: Only 2-D FLOAT32 inputs and states are supported", __func__);
+    }
+
+    const unsigned int batchSize = inputInfo.GetShape()[0];
+    const unsigned int inputSize = inputInfo.GetShape()[1];
+    const unsigned int outputSize = outputStateIn.GetTensorInfo().GetShape()[1];
+    const unsigned int numUnits = cellStateInfo.GetShape()[1];
+    if (!useProjection && outputSize != numUnits)
+    {
+        return Fail("%s: Output size %u must match the number of units %u without projection",
+            __func__, outputSize, numUnits);
+    }
+
+    ActivationFn activation;
+    float cellClip;
+    float projectionClip;
+    if (!GetInputActivationFunction(operation, 20, activation) ||
+        !GetInputFloat32(operation, 21, cellClip) ||
+        !GetInputFloat32(operation, 22, projectionClip))
+    {
+        return Fail("%s: Operation has invalid inputs", __func__);
+    }
+
+    auto isValidFloatTensor = [](const ConstTensorPin& pin, const armnn::TensorShape& shape)
+    {
+        return pin.IsValid() && pin.GetConstTensor().GetShape() == shape &&
+               pin.GetConstTensor().GetDataType() == armnn::DataType::Float32;
+    };
+
+    // All the gates are computed by a single fully connected layer, from the input and output state concatenated.
+    // Its weights are packed here once: the rows for each gate are its input weights followed by its recurrent
+    // weights, and the gates are in the order input (unless CIFG), forget, cell, output.
+    const std::vector<uint32_t> gateWeightsIndices = useCifg ? std::vector<uint32_t>{ 2, 3, 4 }
+                                                             : std::vector<uint32_t>{ 1, 2, 3, 4 };
+    const unsigned int numGates = static_cast<unsigned int>(gateWeightsIndices.size());
+    const unsigned int packedInputSize = inputSize + outputSize;
+
+    // The scratch buffer output holds the gates, before their activations
+    const Operand* scratchOperand = GetOutputOperand(operation, 0);
+    if (scratchOperand == nullptr ||
+        GetTensorShapeForOperand(*scratchOperand) != armnn::TensorShape({ batchSize, numGates * numUnits }))
+    {
+        return Fail("%s: Scratch buffer should be [ %u, %u ]", __func__, batchSize, numGates * numUnits);
+    }
+
+    std::vector<float> packedWeights(numGates * numUnits * packedInputSize);
+    std::vector<float> packedBias(numGates * numUnits);
+    for (unsigned int g = 0; g < numGates; ++g)
+    {
+        const uint32_t inputWeightsIndex = gateWeightsIndices[g];
+        ConstTensorPin inputWeightsPin = ConvertOperationInputToConstTensorPin(operation, inputWeightsIndex);
+        ConstTensorPin recurrentWeightsPin = ConvertOperationInputToConstTensorPin(operation, inputWeightsIndex + 4);
+        ConstTensorPin biasPin = ConvertOperationInputToConstTensorPin(operation, inputWeightsIndex + 11);
+        if (!isValidFloatTensor(inputWeightsPin, armnn::TensorShape({ numUnits, inputSize })) ||
+            !isValidFloatTensor(recurrentWeightsPin, armnn::TensorShape({ numUnits, outputSize })) ||
+            !isValidFloatTensor(biasPin, armnn::TensorShape({ numUnits })))
+        {
+            return Fail("%s: Operation has invalid gate weights or bias", __func__);
+        }
+
+        const float* inputWeights = static_cast<const float*>(inputWeightsPin.GetConstTensor().GetMemoryArea());
+        const float* recurrentWeights =
+            static_cast<const float*>(recurrentWeightsPin.GetConstTensor().GetMemoryArea());
+        for (unsigned int unit = 0; unit < numUnits; ++unit)
+        {
+            float* packedRow = packedWeights.data() + (g * numUnits + unit) * packedInputSize;
+            std::copy_n(inputWeights + unit * inputSize, inputSize, packedRow);
+            std::copy_n(recurrentWeights + unit * outputSize, outputSize, packedRow + inputSize);
+        }
+        std::copy_n(static_cast<const float*>(biasPin.GetConstTensor().GetMemoryArea()), numUnits,
+                    packedBias.data() + g * numUnits);
+    }
+
+    // Helpers adding the layers of the cell, each of which returns an invalid handle if any of its inputs is
+    const char* const operationName = __func__;
+    auto addActivation = [&](LayerInputHandle in, const armnn::ActivationDescriptor& desc)
+    {
+        const armnn::TensorInfo info = in.GetTensorInfo();
+        if (!in.IsValid() ||
+            !IsLayerSupported(operationName, armnn::IsActivationSupported, m_Backends, m_OperationBackendIndex,
+                              info, desc))
+        {
+            return LayerInputHandle();
+        }
+        armnn::IConnectableLayer* const layer = m_Network->AddActivationLayer(desc);
+        assert(layer != nullptr);
+        in.Connect(layer->GetInputSlot(0));
+        layer->GetOutputSlot(0).SetTensorInfo(info);
+        return LayerInputHandle(true, &layer->GetOutputSlot(0), info);
+    };
+
+    auto addMultiplication = [&](LayerInputHandle in0, LayerInputHandle in1)
+    {
+        const armnn::TensorInfo info = in0.GetTensorInfo();
+        if (!in0.IsValid() || !in1.IsValid() ||
+            !IsLayerSupported(operationName, armnn::IsMultiplicationSupported, m_Backends, m_OperationBackendIndex,
+                              info, in1.GetTensorInfo()))
+        {
+            return LayerInputHandle();
+        }
+        armnn::IConnectableLayer* const layer = m_Network->AddMultiplicationLayer();
+        assert(layer != nullptr);
+        in0.Connect(layer->GetInputSlot(0));
+        in1.Connect(layer->GetInputSlot(1));
+        layer->GetOutputSlot(0).SetTensorInfo(info);
+        return LayerInputHandle(true, &layer->GetOutputSlot(0), info);
+    };
+
+    auto addAddition = [&](LayerInputHandle in0, LayerInputHandle in1)
+    {
+        const armnn::TensorInfo info = in0.GetTensorInfo();
+        if (!in0.IsValid() || !in1.IsValid() ||
+            !IsLayerSupported(operationName, armnn::IsAdditionSupported, m_Backends, m_OperationBackendIndex,
+                              info, in1.GetTensorInfo(), info))
+        {
+            return LayerInputHandle();
+        }
+        armnn::IConnectableLayer* const layer = m_Network->AddAdditionLayer();
+        assert(layer != nullptr);
+        in0.Connect(layer->GetInputSlot(0));
+        in1.Connect(layer->GetInputSlot(1));
+        layer->GetOutputSlot(0).SetTensorInfo(info);
+        return LayerInputHandle(true, &layer->GetOutputSlot(0), info);
+    };
+
+    auto addReshape = [&](LayerInputHandle in, const armnn::TensorShape& shape)
+    {
+        armnn::TensorInfo info = in.GetTensorInfo();
+        if (!in.IsValid() ||
+            !IsLayerSupported(operationName, armnn::IsReshapeSupported, m_Backends, m_OperationBackendIndex, info))
+        {
+            return LayerInputHandle();
+        }
+        info.SetShape(shape);
+        armnn::IConnectableLayer* const layer = m_Network->AddReshapeLayer(armnn::ReshapeDescriptor(shape));
+        assert(layer != nullptr);
+        in.Connect(layer->GetInputSlot(0));
+        layer->GetOutputSlot(0).SetTensorInfo(info);
+        return LayerInputHandle(true, &layer->GetOutputSlot(0), info);
+    };
+
+    auto addClip = [&](LayerInputHandle in, float clip)
+    {
+        if (clip <= 0.0f)
+        {
+            return in;
+        }
+        armnn::ActivationDescriptor clipDesc;
+        clipDesc.m_Function = armnn::ActivationFunction::BoundedReLu;
+        clipDesc.m_A = clip;
+        clipDesc.m_B = -clip;
+        return addActivation(in, clipDesc);
+    };
+
+    armnn::ActivationDescriptor cellActivationDesc;
+    if (activation != ActivationFn::kActivationNone && !GetActivationDescriptor(activation, cellActivationDesc))
+    {
+        return Fail("%s: Operation has invalid inputs", __func__);
+    }
+    auto addCellActivation = [&](LayerInputHandle in)
+    {
+        return activation == ActivationFn::kActivationNone ? in : addActivation(in, cellActivationDesc);
+    };
+
+    // Adds the product of the cell state and the peephole weights to a gate. ArmNN's multiplication needs
+    // inputs of the same shape, so the weights are repeated for each batch entry.
+    auto addPeephole = [&](LayerInputHandle gate, LayerInputHandle cellState, uint32_t weightsIndex)
+    {
+        ConstTensorPin weightsPin = ConvertOperationInputToConstTensorPin(operation, weightsIndex);
+        if (!isValidFloatTensor(weightsPin, armnn::TensorShape({ numUnits })))
+        {
+            Fail("%s: Operation has invalid peephole weights", operationName);
+            return LayerInputHandle();
+        }
+
+        const float* weights = static_cast<const float*>(weightsPin.GetConstTensor().GetMemoryArea());
+        std::vector<float> repeatedWeights(batchSize * numUnits);
+        for (unsigned int b = 0; b < batchSize; ++b)
+        {
+            std::copy_n(weights, numUnits, repeatedWeights.data() + b * numUnits);
+        }
+
+        // The constant layer takes a copy of the data
+        const armnn::TensorInfo repeatedInfo(armnn::TensorShape({ batchSize, numUnits }), armnn::DataType::Float32);
+        armnn::IConnectableLayer* const weightsLayer =
+            m_Network->AddConstantLayer(armnn::ConstTensor(repeatedInfo, repeatedWeights.data()));
+        assert(weightsLayer != nullptr);
+        weightsLayer->GetOutputSlot(0).SetTensorInfo(repeatedInfo);
+
+        LayerInputHandle weightsHandle(true, &weightsLayer->GetOutputSlot(0), repeatedInfo);
+        return addAddition(gate, addMultiplication(cellState, weightsHandle));
+    };
+
+    // Concatenate the input and output state, on 4-D views along dimension 1 as the merger requires
+    const std::vector<armnn::TensorShape> concatShapes = { armnn::TensorShape({ batchSize, inputSize, 1, 1 }),
+                                                           armnn::TensorShape({ batchSize, outputSize, 1, 1 }) };
+    LayerInputHandle inputView = addReshape(input, concatShapes[0]);
+    LayerInputHandle outputStateView = addReshape(outputStateIn, concatShapes[1]);
+    if (!inputView.IsValid() || !outputStateView.IsValid())
+    {
+        return false;
+    }
+
+    const armnn::OriginsDescriptor mergerDesc =
+        armnn::CreateMergerDescriptorForConcatenation(concatShapes.begin(), concatShapes.end(), 1);
+    if (!IsLayerSupported(__func__,
+                          armnn::IsMergerSupported,
+                          m_Backends,
+                          m_OperationBackendIndex,
+                          std::vector<const armnn::TensorInfo*>{ &inputView.GetTensorInfo(),
+                                                                 &outputStateView.GetTensorInfo() },
+                          mergerDesc))
+    {
+        return false;
+    }
+
+    armnn::TensorInfo concatInfo = inputInfo;
+    concatInfo.SetShape(armnn::TensorShape({ batchSize, packedInputSize, 1, 1 }));
+    armnn::IConnectableLayer* const mergerLayer = m_Network->AddMergerLayer(mergerDesc);
+    assert(mergerLayer != nullptr);
+    inputView.Connect(mergerLayer->GetInputSlot(0));
+    outputStateView.Connect(mergerLayer->GetInputSlot(1));
+    mergerLayer->GetOutputSlot(0).SetTensorInfo(concatInfo);
+
+    LayerInputHandle packedInput = addReshape(LayerInputHandle(true, &mergerLayer->GetOutputSlot(0), concatInfo),
+                                              armnn::TensorShape({ batchSize, packedInputSize }));
+    if (!packedInput.IsValid())
+    {
+        return false;
+    }
+
+    // The gates, before their activations
+    armnn::FullyConnectedDescriptor gatesDesc;
+    gatesDesc.m_TransposeWeightMatrix = true;
+    gatesDesc.m_BiasEnabled           = true;
+    if (!IsLayerSupported(__func__,
+                          armnn::IsFullyConnectedSupported,
+                          m_Backends,
+                          m_OperationBackendIndex,
+                          packedInput.GetTensorInfo(),
+                          gatesDesc))
+    {
+        return false;
+    }
+
+    const armnn::TensorInfo packedWeightsInfo(armnn::TensorShape({ numGates * numUnits, packedInputSize }),
+                                              armnn::DataType::Float32);
+    const armnn::TensorInfo packedBiasInfo(armnn::TensorShape({ numGates * numUnits }), armnn::DataType::Float32);
+    armnn::TensorInfo gatesInfo = inputInfo;
+    gatesInfo.SetShape(armnn::TensorShape({ batchSize, numGates * numUnits }));
+
+    // The layer takes copies of the weights and bias
+    armnn::IConnectableLayer* const gatesLayer = m_Network->AddFullyConnectedLayer(gatesDesc,
+        armnn::ConstTensor(packedWeightsInfo, packedWeights.data()),
+        armnn::ConstTensor(packedBiasInfo, packedBias.data()));
+    assert(gatesLayer != nullptr);
+    packedInput.Connect(gatesLayer->GetInputSlot(0));
+    gatesLayer->GetOutputSlot(0).SetTensorInfo(gatesInfo);
+
+    armnn::ViewsDescriptor splitterDesc(numGates, 2);
+    for (unsigned int g = 0; g < numGates; ++g)
+    {
+        splitterDesc.SetViewOriginCoord(g, 0, 0);
+        splitterDesc.SetViewOriginCoord(g, 1, g * numUnits);
+        splitterDesc.SetViewSize(g, 0, batchSize);
+        splitterDesc.SetViewSize(g, 1, numUnits);
+    }
+    if (!IsLayerSupported(__func__,
+                          armnn::IsSplitterSupported,
+                          m_Backends,
+                          m_OperationBackendIndex,
+                          gatesInfo,
+                          splitterDesc))
+    {
+        return false;
+    }
+
+    armnn::IConnectableLayer* const splitterLayer = m_Network->AddSplitterLayer(splitterDesc);
+    assert(splitterLayer != nullptr);
+    gatesLayer->GetOutputSlot(0).Connect(splitterLayer->GetInputSlot(0));
+    std::vector<LayerInputHandle> gates;
+    for (unsigned int g = 0; g < numGates; ++g)
+    {
+        splitterLayer->GetOutputSlot(g).SetTensorInfo(cellStateInfo);
+        gates.emplace_back(true, &splitterLayer->GetOutputSlot(g), cellStateInfo);
+    }
+    const unsigned int firstGate = useCifg ? 1 : 0;
+    LayerInputHandle forgetGate = gates[1 - firstGate];
+    LayerInputHandle cellGate = gates[2 - firstGate];
+    LayerInputHandle outputGate = gates[3 - firstGate];
+
+    armnn::ActivationDescriptor sigmoidDesc;
+    sigmoidDesc.m_Function = armnn::ActivationFunction::Sigmoid;
+
+    if (usePeephole)
+    {
+        forgetGate = addPeephole(forgetGate, cellStateIn, 10);
+    }
+    forgetGate = addActivation(forgetGate, sigmoidDesc);
+
+    LayerInputHandle inputGate;
+    if (useCifg)
+    {
+        // The input gate is 1 - forget gate
+        armnn::ActivationDescriptor complementDesc;
+        complementDesc.m_Function = armnn::ActivationFunction::Linear;
+        complementDesc.m_A = -1.0f;
+        complementDesc.m_B = 1.0f;
+        inputGate = addActivation(forgetGate, complementDesc);
+    }
+    else
+    {
+        inputGate = usePeephole ? addPeephole(gates[0], cellStateIn, 9) : gates[0];
+        inputGate = addActivation(inputGate, sigmoidDesc);
+    }
+
+    cellGate = addCellActivation(cellGate);
+
+    // cell state = forget gate * cell state in + input gate * cell gate
+    LayerInputHandle retainedCellState = addMultiplication(forgetGate, cellStateIn);
+    LayerInputHandle newCellState = addMultiplication(inputGate, cellGate);
+    LayerInputHandle cellState = addClip(addAddition(retainedCellState, newCellState), cellClip);
+
+    // The output gate's peephole uses the new cell state
+    if (usePeephole)
+    {
+        outputGate = addPeephole(outputGate, cellState, 11);
+    }
+    outputGate = addActivation(outputGate, sigmoidDesc);
+
+    LayerInputHandle outputState = addMultiplication(outputGate, addCellActivation(cellState));
+    if (!outputState.IsValid())
+    {
+        return false;
+    }
+
+    if (useProjection)
+    {
+        ConstTensorPin projectionWeightsPin = ConvertOperationInputToConstTensorPin(operation, 16);
+        const bool hasProjectionBias = !isOmitted(17);
+        ConstTensorPin projectionBiasPin = hasProjectionBias ? ConvertOperationInputToConstTensorPin(operation, 17)
+                                                             : ConstTensorPin();
+        if (!isValidFloatTensor(projectionWeightsPin, armnn::TensorShape({ outputSize, numUnits })) ||
+            (hasProjectionBias && !isValidFloatTensor(projectionBiasPin, armnn::TensorShape({ outputSize }))))
+        {
+            return Fail("%s: Operation has invalid projection weights or bias", __func__);
+        }
+
+        armnn::FullyConnectedDescriptor projectionDesc;
+        projectionDesc.m_TransposeWeightMatrix = true;
+        projectionDesc.m_BiasEnabled           = hasProjectionBias;
+        if (!IsLayerSupported(__func__,
+                              armnn::IsFullyConnectedSupported,
+                              m_Backends,
+                              m_OperationBackendIndex,
+                              outputState.GetTensorInfo(),
+                              projectionDesc))
+        {
+            return false;
+        }
+
+        armnn::IConnectableLayer* const projectionLayer = hasProjectionBias ?
+            m_Network->AddFullyConnectedLayer(projectionDesc, projectionWeightsPin.GetConstTensor(),
+                                              projectionBiasPin.GetConstTensor()) :
+            m_Network->AddFullyConnectedLayer(projectionDesc, projectionWeightsPin.GetConstTensor());
+        assert(projectionLayer != nullptr);
+        outputState.Connect(projectionLayer->GetInputSlot(0));
+
+        armnn::TensorInfo projectionInfo = inputInfo;
+        projectionInfo.SetShape(armnn::TensorShape({ batchSize, outputSize }));
+        projectionLayer->GetOutputSlot(0).SetTensorInfo(projectionInfo);
+
+        outputState = addClip(LayerInputHandle(true, &projectionLayer->GetOutputSlot(0), projectionInfo),
+                              projectionClip);
+        if (!outputState.IsValid())
+        {
+            return false;
+        }
+    }
+
+    return SetupAndTrackOutputSlot(operation, 0, gatesLayer->GetOutputSlot(0)) &&
+           SetupAndTrackOutputSlot(operation, 1, *outputState.GetOutputSlot()) &&
+           SetupAndTrackOutputSlot(operation, 2, *cellState.GetOutputSlot()) &&
+           SetupAndTrackOutputSlot(operation, 3, *outputState.GetOutputSlot());
 }
 
 bool ModelToINetworkConverter::ConvertMaxPool2d(const V1_0::Operation& operation)
@@ -1215,8 +3339,13 @@ bool ModelToINetworkConverter::ConvertMaxPool2d(const V1_0::Operation& operation
 
 bool ModelToINetworkConverter::ConvertMul(const V1_0::Operation& operation)
 {
-    LayerInputHandle input0 = ConvertToLayerInputHandle(operation, 0);
-    LayerInputHandle input1 = ConvertToLayerInputHandle(operation, 1);
+    // The multiplication is independent of the layout, so use whichever avoids the most permute layers
+    const bool useSwizzledInputs = ShouldUseSwizzledInputs(operation, 2);
+
+    LayerInputHandle input0 = useSwizzledInputs ? ConvertToSwizzledLayerInputHandle(operation, 0)
+                                                : ConvertToLayerInputHandle(operation, 0);
+    LayerInputHandle input1 = useSwizzledInputs ? ConvertToSwizzledLayerInputHandle(operation, 1)
+                                                : ConvertToLayerInputHandle(operation, 1);
 
     if (!input0.IsValid() || !input1.IsValid())
     {
@@ -1229,28 +3358,55 @@ bool ModelToINetworkConverter::ConvertMul(const V1_0::Operation& operation)
         return Fail("%s: Operation has invalid inputs", __func__);
     }
 
+    const Operand* outputOperand = GetOutputOperand(operation, 0);
+
+    if (outputOperand == nullptr)
+    {
+        return false;
+    }
+
     if (!ValidateBroadcast(m_Model, operation, 2u))
     {
         return Fail("%s is invalid due to broadcasting", __func__);
     }
 
-    if (!IsLayerSupported(__func__,
-                          armnn::IsMultiplicationSupported,
-                          m_Compute,
-                          input0.GetTensorInfo(),
-                          input1.GetTensorInfo()))
+    armnn::TensorInfo outInfo = GetTensorInfoForOperand(*outputOperand);
+    if (useSwizzledInputs)
     {
-        return false;
+        outInfo = armnnUtils::Permuted(outInfo, NHWCToArmNN);
     }
 
-    const Operand* outputOperand = GetOutputOperand(operation, 0);
+    const armnn::TensorInfo& inputInfo0 = input0.GetTensorInfo();
+    const armnn::TensorInfo& inputInfo1 = input1.GetTensorInfo();
+    if (inputInfo0.GetDataType() != outInfo.GetDataType() || inputInfo1.GetDataType() != outInfo.GetDataType())
+    {
+        return Fail("%s: Inputs and output must have the same data type", __func__);
+    }
 
-    if (outputOperand == nullptr)
+    // As required by AndroidNN, so that the rescaling of the product to the output is a multiplier below 1
+    if (outInfo.GetDataType() == armnn::DataType::QuantisedAsymm8 &&
+        !(outInfo.GetQuantizationScale() > inputInfo0.GetQuantizationScale() * inputInfo1.GetQuantizationScale()))
+    {
+        return Fail("%s: Output scale %f must be greater than the product of the input scales (%f * %f)", __func__,
+            outInfo.GetQuantizationScale(), inputInfo0.GetQuantizationScale(), inputInfo1.GetQuantizationScale());
+    }
+
+    // ArmNN's multiplication needs inputs of the same shape
+    if (!ExpandToRank(input0, outInfo.GetNumDimensions()) || !ExpandToRank(input1, outInfo.GetNumDimensions()) ||
+        !BroadcastLayerInput(input0, outInfo.GetShape()) || !BroadcastLayerInput(input1, outInfo.GetShape()))
     {
         return false;
     }
 
-    const armnn::TensorInfo& outInfo = GetTensorInfoForOperand(*outputOperand);
+    if (!IsLayerSupported(__func__,
+                          armnn::IsMultiplicationSupported,
+                          m_Backends,
+                          m_OperationBackendIndex,
+                          input0.GetTensorInfo(),
+                          input1.GetTensorInfo()))
+    {
+        return false;
+    }
 
     armnn::IConnectableLayer* const startLayer = m_Network->AddMultiplicationLayer();
     armnn::IConnectableLayer* const endLayer = ProcessActivation(outInfo, activationFunction, startLayer);
@@ -1260,7 +3416,8 @@ bool ModelToINetworkConverter::ConvertMul(const V1_0::Operation& operation)
         input0.Connect(startLayer->GetInputSlot(0));
         input1.Connect(startLayer->GetInputSlot(1));
 
-        return SetupAndTrackLayerOutputSlot(operation, 0, *endLayer);
+        return useSwizzledInputs ? SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *endLayer)
+                                 : SetupAndTrackLayerOutputSlot(operation, 0, *endLayer);
     }
     else
     {
@@ -1311,7 +3468,8 @@ bool ModelToINetworkConverter::ConvertSoftmax(const V1_0::Operation& operation)
 
     if (!IsLayerSupported(__func__,
                           armnn::IsSoftmaxSupported,
-                          m_Compute,
+                          m_Backends,
+                          m_OperationBackendIndex,
                           input.GetTensorInfo(),
                           desc))
     {
@@ -1377,7 +3535,15 @@ bool ModelToINetworkConverter::ConvertReshape(const V1_0::Operation& operation)
         return Fail("%s: Shape of output operand does not match resolved requested shape", __func__);
     }
 
-    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    // A reshape to the shape the input already has doesn't need a layer
+    if (SameShape(inputOperandShape, outputOperandShape) &&
+        inputOperand->scale == outputOperand->scale &&
+        inputOperand->zeroPoint == outputOperand->zeroPoint)
+    {
+        return AliasOperand(operation, 0, 0);
+    }
+
+    LayerInputHandle input = ConvertToLayerInputHandleForReshape(operation, 0);
     if (!input.IsValid())
     {
         return Fail("%s: Could not read input 0", __func__);
@@ -1385,7 +3551,8 @@ bool ModelToINetworkConverter::ConvertReshape(const V1_0::Operation& operation)
 
     if (!IsLayerSupported(__func__,
                           armnn::IsReshapeSupported,
-                          m_Compute,
+                          m_Backends,
+                          m_OperationBackendIndex,
                           input.GetTensorInfo()))
     {
         return false;
@@ -1405,7 +3572,7 @@ bool ModelToINetworkConverter::ConvertReshape(const V1_0::Operation& operation)
 
 bool ModelToINetworkConverter::ConvertResizeBilinear(const V1_0::Operation& operation)
 {
-    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    LayerInputHandle input = ConvertToSwizzledLayerInputHandle(operation, 0);
     if (!input.IsValid())
     {
         return Fail("%s: Could not read input 0", __func__);
@@ -1417,15 +3584,13 @@ bool ModelToINetworkConverter::ConvertResizeBilinear(const V1_0::Operation& oper
         return Fail("%s: Could not read output 0", __func__);
     }
 
-    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
-    const armnn::TensorInfo& outputInfo = GetTensorInfoForOperand(*output);
-
-    const armnn::TensorInfo swizzledInputInfo = armnnUtils::Permuted(inputInfo, NHWCToArmNN);
-    const armnn::TensorInfo swizzledOutputInfo = armnnUtils::Permuted(outputInfo, NHWCToArmNN);
+    const armnn::TensorInfo& swizzledInputInfo = input.GetTensorInfo();
+    const armnn::TensorInfo swizzledOutputInfo = GetSwizzledTensorInfoForOperand(*output);
 
     if (!IsLayerSupported(__func__,
                           armnn::IsResizeBilinearSupported,
-                          m_Compute,
+                          m_Backends,
+                          m_OperationBackendIndex,
                           swizzledInputInfo))
     {
         return false;
@@ -1443,17 +3608,20 @@ bool ModelToINetworkConverter::ConvertResizeBilinear(const V1_0::Operation& oper
     assert(layer != nullptr);
     layer->GetOutputSlot(0).SetTensorInfo(swizzledOutputInfo);
 
-    armnn::IConnectableLayer& outSwizzleLayer = SwizzleInDeswizzleOut(*m_Network, input, *layer);
-
-    return SetupAndTrackLayerOutputSlot(operation, 0, outSwizzleLayer);
+    input.Connect(layer->GetInputSlot(0));
 
+    return SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *layer);
 }
 
 bool ModelToINetworkConverter::ConvertToActivation(const V1_0::Operation& operation,
     const char* operationName,
     const armnn::ActivationDescriptor& activationDesc)
 {
-    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    // Element-wise activations are independent of the layout, so use whichever avoids the most permute layers
+    const bool useSwizzledInputs = ShouldUseSwizzledInputs(operation, 1);
+
+    LayerInputHandle input = useSwizzledInputs ? ConvertToSwizzledLayerInputHandle(operation, 0)
+                                               : ConvertToLayerInputHandle(operation, 0);
     if (!input.IsValid())
     {
         return Fail("%s: Input 0 is invalid", operationName);
@@ -1461,7 +3629,8 @@ bool ModelToINetworkConverter::ConvertToActivation(const V1_0::Operation& operat
 
     if (!IsLayerSupported(__func__,
                           armnn::IsActivationSupported,
-                          m_Compute,
+                          m_Backends,
+                          m_OperationBackendIndex,
                           input.GetTensorInfo(),
                           activationDesc))
     {
@@ -1472,14 +3641,15 @@ bool ModelToINetworkConverter::ConvertToActivation(const V1_0::Operation& operat
     assert(layer != nullptr);
     input.Connect(layer->GetInputSlot(0));
 
-    return SetupAndTrackLayerOutputSlot(operation, 0, *layer);
+    return useSwizzledInputs ? SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *layer)
+                             : SetupAndTrackLayerOutputSlot(operation, 0, *layer);
 }
 
 bool ModelToINetworkConverter::ConvertPooling2d(const V1_0::Operation& operation,
     const char* operationName,
     armnn::PoolingAlgorithm poolType)
 {
-    LayerInputHandle input = ConvertToLayerInputHandle(operation, 0);
+    LayerInputHandle input = ConvertToSwizzledLayerInputHandle(operation, 0);
     if (!input.IsValid())
     {
         return Fail("%s: Could not read input 0", operationName);
@@ -1491,11 +3661,8 @@ bool ModelToINetworkConverter::ConvertPooling2d(const V1_0::Operation& operation
         return Fail("%s: Could not read output 0", __func__);
     }
 
-    const armnn::TensorInfo& inputInfo = input.GetTensorInfo();
-    const armnn::TensorInfo& outputInfo = GetTensorInfoForOperand(*output);
-
-    const armnn::TensorInfo swizzledInputInfo = armnnUtils::Permuted(inputInfo, NHWCToArmNN);
-    const armnn::TensorInfo swizzledOutputInfo = armnnUtils::Permuted(outputInfo, NHWCToArmNN);
+    const armnn::TensorInfo& swizzledInputInfo = input.GetTensorInfo();
+    const armnn::TensorInfo swizzledOutputInfo = GetSwizzledTensorInfoForOperand(*output);
 
     armnn::Pooling2dDescriptor desc;
     desc.m_PoolType = poolType;
@@ -1541,6 +3708,17 @@ bool ModelToINetworkConverter::ConvertPooling2d(const V1_0::Operation& operation
         }
     }
 
+    // A 1x1 pool with unit strides, no padding and no activation passes its input through unchanged,
+    // so its output can simply refer to its input
+    if (desc.m_PoolWidth == 1 && desc.m_PoolHeight == 1 &&
+        desc.m_StrideX == 1 && desc.m_StrideY == 1 &&
+        desc.m_PadLeft == 0 && desc.m_PadRight == 0 && desc.m_PadTop == 0 && desc.m_PadBottom == 0 &&
+        activation == ActivationFn::kActivationNone &&
+        swizzledInputInfo == swizzledOutputInfo)
+    {
+        return AliasOperand(operation, 0, 0);
+    }
+
     // ArmNN does not accept a pool size of 1, but the ArmNN driver is expected to cope.
     // This is mapped to a trivial splitter instead.
     armnn::IConnectableLayer* startLayer = nullptr;
@@ -1548,7 +3726,8 @@ bool ModelToINetworkConverter::ConvertPooling2d(const V1_0::Operation& operation
     {
         if (!IsLayerSupported(__func__,
                               armnn::IsPooling2dSupported,
-                              m_Compute,
+                              m_Backends,
+                              m_OperationBackendIndex,
                               swizzledInputInfo,
                               swizzledOutputInfo,
                               desc))
@@ -1572,7 +3751,8 @@ bool ModelToINetworkConverter::ConvertPooling2d(const V1_0::Operation& operation
 
         if (!IsLayerSupported(__func__,
                               armnn::IsSplitterSupported,
-                              m_Compute,
+                              m_Backends,
+                              m_OperationBackendIndex,
                               swizzledInputInfo,
                               viewsDesc))
         {
@@ -1586,8 +3766,8 @@ bool ModelToINetworkConverter::ConvertPooling2d(const V1_0::Operation& operation
 
     if (endLayer != nullptr)
     {
-        armnn::IConnectableLayer& outSwizzleLayer = SwizzleInDeswizzleOut(*m_Network, input, *startLayer, *endLayer);
-        return SetupAndTrackLayerOutputSlot(operation, 0, outSwizzleLayer);
+        input.Connect(startLayer->GetInputSlot(0));
+        return SetupAndTrackSwizzledLayerOutputSlot(operation, 0, *endLayer);
     }
     else
     {
@@ -1604,7 +3784,7 @@ const void* ModelToINetworkConverter::GetOperandValueReadOnlyAddress(const Opera
         case OperandLifeTime::CONSTANT_COPY:
         {
             // Constant found in model.operandValues
-            valueStart = &m_Model.operandValues[operand.location.offset];
+            valueStart = &m_OperandValues[operand.location.offset];
             break;
         }
         case OperandLifeTime::CONSTANT_REFERENCE:
@@ -1649,6 +3829,42 @@ const Operand* ModelToINetworkConverter::GetOutputOperand(const V1_0::Operation&
     return &m_Model.operands[operation.outputs[outputIndex]];
 }
 
+armnn::TensorInfo ModelToINetworkConverter::GetTensorInfoForOperand(const Operand& operand) const
+{
+    const std::less<const Operand*> before;
+    const Operand* const operands = m_Model.operands.data();
+    if (before(&operand, operands) || !before(&operand, operands + m_OperandTensorInfos.size()))
+    {
+        return armnn_driver::GetTensorInfoForOperand(operand);
+    }
+
+    OperandTensorInfos& infos = m_OperandTensorInfos[&operand - operands];
+    if (!infos.m_HasTensorInfo)
+    {
+        infos.m_TensorInfo = armnn_driver::GetTensorInfoForOperand(operand);
+        infos.m_HasTensorInfo = true;
+    }
+    return infos.m_TensorInfo;
+}
+
+armnn::TensorInfo ModelToINetworkConverter::GetSwizzledTensorInfoForOperand(const Operand& operand) const
+{
+    const std::less<const Operand*> before;
+    const Operand* const operands = m_Model.operands.data();
+    if (before(&operand, operands) || !before(&operand, operands + m_OperandTensorInfos.size()))
+    {
+        return armnnUtils::Permuted(armnn_driver::GetTensorInfoForOperand(operand), NHWCToArmNN);
+    }
+
+    OperandTensorInfos& infos = m_OperandTensorInfos[&operand - operands];
+    if (!infos.m_HasSwizzledTensorInfo)
+    {
+        infos.m_SwizzledTensorInfo = armnnUtils::Permuted(GetTensorInfoForOperand(operand), NHWCToArmNN);
+        infos.m_HasSwizzledTensorInfo = true;
+    }
+    return infos.m_SwizzledTensorInfo;
+}
+
 template<typename T>
 bool ModelToINetworkConverter::GetInputScalar(const V1_0::Operation& operation, uint32_t inputIndex,
     OperandType type, T& outValue) const
@@ -1744,42 +3960,72 @@ LayerInputHandle ModelToINetworkConverter::ConvertToLayerInputHandle(
     {
         case OperandLifeTime::TEMPORARY_VARIABLE: // intentional fallthrough
         case OperandLifeTime::MODEL_INPUT:
+        case OperandLifeTime::MODEL_OUTPUT:
         {
-            // The tensor is either an operand internal to the model, or a model input.
-            // It can be associated with an ArmNN output slot for an existing layer.
+            // The tensor is either an operand internal to the model, a model input, or a model output also
+            // used within the model. It can be associated with an ArmNN output slot for an existing layer.
 
-            // m_OutputSlotForOperand[...] can be nullptr if the previous layer could not be converted
+            // The output slot can be nullptr if the previous layer could not be converted
             const uint32_t operandIndex = operation.inputs[inputIndex];
-            return LayerInputHandle(true, m_OutputSlotForOperand[operandIndex], operandTensorInfo);
+            return LayerInputHandle(true, GetOutputSlotForOperand(operandIndex), operandTensorInfo);
             break;
         }
         case OperandLifeTime::CONSTANT_COPY:
         case OperandLifeTime::CONSTANT_REFERENCE:
         {
             // The tensor has an already known constant value, and can be converted into an ArmNN Constant layer.
-            ConstTensorPin tensorPin = ConvertOperandToConstTensorPin(*operand);
-            if (tensorPin.IsValid())
-            {
-                if (!IsLayerSupported(__func__,
-                                      armnn::IsConstantSupported,
-                                      m_Compute,
-                                      tensorPin.GetConstTensor().GetInfo()))
-                {
-                    return LayerInputHandle();
-                }
+            return ConvertToConstLayerInputHandle(*operand, operation.inputs[inputIndex], false);
+        }
+        default:
+        {
+            // Unsupported lifetime for an input tensor
+            Fail("%s: unsupported lifetime for input tensor: %s",
+                __func__, toString(operand->lifetime).c_str());
+            return LayerInputHandle();
+        }
+    }
+}
 
-                armnn::IConnectableLayer* constantLayer = m_Network->AddConstantLayer(tensorPin.GetConstTensor());
-                armnn::IOutputSlot& outputSlot = constantLayer->GetOutputSlot(0);
-                outputSlot.SetTensorInfo(tensorPin.GetConstTensor().GetInfo());
+LayerInputHandle ModelToINetworkConverter::ConvertToSwizzledLayerInputHandle(
+    const V1_0::Operation& operation,
+    uint32_t inputIndex)
+{
+    const Operand* operand = GetInputOperand(operation, inputIndex);
+    if (!operand)
+    {
+        Fail("%s: failed to get input operand %i", __func__, inputIndex);
+        return LayerInputHandle();
+    }
 
-                return LayerInputHandle(true, &outputSlot, operandTensorInfo);
-            }
-            else
-            {
-                Fail("%s: invalid operand tensor", __func__);
-                return LayerInputHandle();
-            }
-            break;
+    if (!IsOperandTypeSupportedForTensors(operand->type))
+    {
+        Fail("%s: unsupported operand type for tensor %s", __func__, toString(operand->type).c_str());
+        return LayerInputHandle();
+    }
+
+    if (operand->dimensions.size() != 4)
+    {
+        Fail("%s: only 4D tensors can be swizzled (found %i dimensions)", __func__, operand->dimensions.size());
+        return LayerInputHandle();
+    }
+
+    const armnn::TensorInfo swizzledTensorInfo = GetSwizzledTensorInfoForOperand(*operand);
+
+    switch (operand->lifetime)
+    {
+        case OperandLifeTime::TEMPORARY_VARIABLE: // intentional fallthrough
+        case OperandLifeTime::MODEL_INPUT:
+        case OperandLifeTime::MODEL_OUTPUT:
+        {
+            // The output slot can be nullptr if the previous layer could not be converted
+            const uint32_t operandIndex = operation.inputs[inputIndex];
+            return LayerInputHandle(true, GetSwizzledOutputSlotForOperand(operandIndex), swizzledTensorInfo);
+        }
+        case OperandLifeTime::CONSTANT_COPY:
+        case OperandLifeTime::CONSTANT_REFERENCE:
+        {
+            // Constant data is swizzled during the conversion, so no permute layer is needed
+            return ConvertToConstLayerInputHandle(*operand, operation.inputs[inputIndex], true);
         }
         default:
         {
@@ -1791,6 +4037,167 @@ LayerInputHandle ModelToINetworkConverter::ConvertToLayerInputHandle(
     }
 }
 
+LayerInputHandle ModelToINetworkConverter::ConvertToLayerInputHandleForReshape(
+    const V1_0::Operation& operation,
+    uint32_t inputIndex)
+{
+    // A reshape doesn't care about the layout of its input if swizzling the input only changes its shape,
+    // so in that case use the swizzled tensor directly if it is the only one available.
+    const Operand* operand = GetInputOperand(operation, inputIndex);
+    if (operand != nullptr &&
+        operand->dimensions.size() == 4 &&
+        IsOperandFromLayer(*operand))
+    {
+        const uint32_t operandIndex = operation.inputs[inputIndex];
+        if (m_OutputSlotForOperand[operandIndex] == nullptr &&
+            m_SwizzledOutputSlotForOperand[operandIndex] != nullptr &&
+            IsSwizzleEquivalentToReshape(GetTensorShapeForOperand(*operand)))
+        {
+            return ConvertToSwizzledLayerInputHandle(operation, inputIndex);
+        }
+    }
+
+    return ConvertToLayerInputHandle(operation, inputIndex);
+}
+
+LayerInputHandle ModelToINetworkConverter::ConvertToConstLayerInputHandle(const Operand& operand,
+                                                                          uint32_t operandIndex,
+                                                                          bool swizzled,
+                                                                          bool shareLayer)
+{
+    // Each constant is only added to the network once (per layout), however many operations use it
+    std::vector<armnn::IOutputSlot*>& outputSlots = swizzled ? m_SwizzledOutputSlotForOperand : m_OutputSlotForOperand;
+    if (shareLayer && outputSlots[operandIndex] != nullptr)
+    {
+        return LayerInputHandle(true, outputSlots[operandIndex], outputSlots[operandIndex]->GetTensorInfo());
+    }
+
+    if (swizzled && operand.dimensions.size() != 4)
+    {
+        Fail("%s: only 4D tensors can be swizzled (found %i dimensions)", __func__, operand.dimensions.size());
+        return LayerInputHandle();
+    }
+
+    const ConstTensorPin tensorPin = ConvertOperandToConstTensorPin(operand, swizzled ? NHWCToArmNN : g_DontPermute);
+    if (!tensorPin.IsValid())
+    {
+        Fail("%s: invalid operand tensor", __func__);
+        return LayerInputHandle();
+    }
+
+    const armnn::TensorInfo& tensorInfo = tensorPin.GetConstTensor().GetInfo();
+    if (!IsLayerSupported(__func__,
+                          armnn::IsConstantSupported,
+                          m_Backends,
+                          m_OperationBackendIndex,
+                          tensorInfo))
+    {
+        return LayerInputHandle();
+    }
+
+    armnn::IConnectableLayer* constantLayer = m_Network->AddConstantLayer(tensorPin.GetConstTensor());
+    armnn::IOutputSlot& outputSlot = constantLayer->GetOutputSlot(0);
+    outputSlot.SetTensorInfo(tensorInfo);
+
+    if (shareLayer)
+    {
+        outputSlots[operandIndex] = &outputSlot;
+    }
+
+    return LayerInputHandle(true, &outputSlot, tensorInfo);
+}
+
+bool ModelToINetworkConverter::ShouldUseSwizzledInputs(const V1_0::Operation& operation, uint32_t numInputs) const
+{
+    // Layout independent operations can work on 4D tensors in either layout. Pick the layout that needs the
+    // fewest permute layers to provide the inputs, preferring the ArmNN layout (as used by the surrounding
+    // convolutions, poolings, etc.) when that is where the inputs are coming from.
+    unsigned int numPermutesIfSwizzled = 0;
+    unsigned int numPermutesIfNotSwizzled = 0;
+    bool anySwizzledInput = false;
+
+    for (uint32_t i = 0; i < numInputs; ++i)
+    {
+        const Operand* operand = GetInputOperand(operation, i);
+        if (operand == nullptr || operand->dimensions.size() != 4)
+        {
+            return false;
+        }
+
+        // Constant inputs are permuted during the conversion, so they are free in either layout
+        if (IsOperandFromLayer(*operand))
+        {
+            const uint32_t operandIndex = operation.inputs[i];
+            if (m_SwizzledOutputSlotForOperand[operandIndex] != nullptr)
+            {
+                anySwizzledInput = true;
+            }
+            else
+            {
+                ++numPermutesIfSwizzled;
+            }
+
+            if (m_OutputSlotForOperand[operandIndex] == nullptr)
+            {
+                ++numPermutesIfNotSwizzled;
+            }
+        }
+    }
+
+    return anySwizzledInput && numPermutesIfSwizzled <= numPermutesIfNotSwizzled;
+}
+
+armnn::IOutputSlot* ModelToINetworkConverter::GetOutputSlotForOperand(uint32_t operandIndex)
+{
+    armnn::IOutputSlot* outputSlot = m_OutputSlotForOperand[operandIndex];
+    armnn::IOutputSlot* swizzledOutputSlot = m_SwizzledOutputSlotForOperand[operandIndex];
+
+    if (outputSlot == nullptr && swizzledOutputSlot != nullptr)
+    {
+        // Only available in the ArmNN layout so far: add a deswizzle layer, shared by all later consumers
+        outputSlot = &AddPermuteLayer(*swizzledOutputSlot, ArmNNToNHWC).GetOutputSlot(0);
+        m_OutputSlotForOperand[operandIndex] = outputSlot;
+    }
+
+    return outputSlot;
+}
+
+armnn::IOutputSlot* ModelToINetworkConverter::GetSwizzledOutputSlotForOperand(uint32_t operandIndex)
+{
+    armnn::IOutputSlot* outputSlot = m_OutputSlotForOperand[operandIndex];
+    armnn::IOutputSlot* swizzledOutputSlot = m_SwizzledOutputSlotForOperand[operandIndex];
+
+    if (swizzledOutputSlot == nullptr && outputSlot != nullptr)
+    {
+        // Only available in the AndroidNN layout so far: add a swizzle layer, shared by all later consumers
+        swizzledOutputSlot = &AddPermuteLayer(*outputSlot, NHWCToArmNN).GetOutputSlot(0);
+        m_SwizzledOutputSlotForOperand[operandIndex] = swizzledOutputSlot;
+    }
+
+    return swizzledOutputSlot;
+}
+
+template<typename OSlot>
+armnn::IConnectableLayer& ModelToINetworkConverter::AddPermuteLayer(OSlot& input,
+                                                                     const armnn::PermutationVector& mappings)
+{
+    ++m_NumPermuteLayers;
+    armnn::IConnectableLayer& layer = ::AddPermuteLayer(*m_Network, input, mappings);
+
+    // A permute reads and writes the whole tensor
+    const double permuteBytes = 2.0 * layer.GetOutputSlot(0).GetTensorInfo().GetNumBytes();
+    if (m_CurrentOperationIndex < m_OperationCosts.size())
+    {
+        m_OperationCosts[m_CurrentOperationIndex].m_PermuteBytes += permuteBytes;
+    }
+    else
+    {
+        m_OutputPermuteBytes += permuteBytes;
+    }
+
+    return layer;
+}
+
 ConstTensorPin ModelToINetworkConverter::ConvertOperationInputToConstTensorPin(const V1_0::Operation& operation,
     uint32_t inputIndex, const armnn::PermutationVector& dimensionMappings,
     const armnn::TensorShape* overrideTensorShape)
@@ -1879,46 +4286,18 @@ armnn::IConnectableLayer* ModelToINetworkConverter::ProcessActivation(const armn
     if (activation != ActivationFn::kActivationNone)
     {
         armnn::ActivationDescriptor activationDesc;
-        switch (activation)
+        if (!GetActivationDescriptor(activation, activationDesc))
         {
-            case ActivationFn::kActivationRelu:
-            {
-                activationDesc.m_Function = armnn::ActivationFunction::ReLu;
-                break;
-            }
-            case ActivationFn::kActivationRelu1:
-            {
-                activationDesc.m_Function = armnn::ActivationFunction::BoundedReLu;
-                activationDesc.m_A = 1.0f;
-                activationDesc.m_B = -1.0f;
-                break;
-            }
-            case ActivationFn::kActivationRelu6:
-            {
-                activationDesc.m_Function = armnn::ActivationFunction::BoundedReLu;
-                activationDesc.m_A = 6.0f;
-                break;
-            }
-            case ActivationFn::kActivationSigmoid:
-            {
-                activationDesc.m_Function = armnn::ActivationFunction::Sigmoid;
-                break;
-            }
-            case ActivationFn::kActivationTanh:
-            {
-                activationDesc.m_Function = armnn::ActivationFunction::TanH;
-                activationDesc.m_A = 1.0f;
-                activationDesc.m_B = 1.0f;
-                break;
-            }
-            default:
-            {
-                Fail("%s: Invalid activation enum value %i", __func__, activation);
-                return nullptr;
-            }
+            return nullptr;
+        }
+
+        if (IsActivationRedundant(tensorInfo, activationDesc))
+        {
+            ALOGV("%s: Skipping activation %i, as the quantized output range is within it", __func__, activation);
+            return prevLayer;
         }
 
-        if (!IsLayerSupported(__func__, armnn::IsActivationSupported, m_Compute,
+        if (!IsLayerSupported(__func__, armnn::IsActivationSupported, m_Backends, m_OperationBackendIndex,
                               prevLayer->GetOutputSlot(0).GetTensorInfo(), activationDesc))
         {
             return nullptr;
@@ -1935,6 +4314,36 @@ armnn::IConnectableLayer* ModelToINetworkConverter::ProcessActivation(const armn
 
 bool ModelToINetworkConverter::SetupAndTrackLayerOutputSlot(const V1_0::Operation& operation, uint32_t outputIndex,
                                                             armnn::IConnectableLayer& layer)
+{
+    if (outputIndex >= layer.GetNumOutputSlots())
+    {
+        return false;
+    }
+
+    return SetupAndTrackOutputSlot(operation, outputIndex, layer.GetOutputSlot(outputIndex));
+}
+
+bool ModelToINetworkConverter::SetupAndTrackOutputSlot(const V1_0::Operation& operation, uint32_t outputIndex,
+                                                       armnn::IOutputSlot& outputSlot)
+{
+    const Operand* outputOperand = GetOutputOperand(operation, outputIndex);
+
+    if (outputOperand == nullptr)
+    {
+        return false;
+    }
+
+    const uint32_t operandIndex = operation.outputs[outputIndex];
+    m_OutputSlotForOperand[operandIndex] = &outputSlot;
+
+    outputSlot.SetTensorInfo(GetTensorInfoForOperand(*outputOperand));
+
+    return true;
+}
+
+bool ModelToINetworkConverter::SetupAndTrackSwizzledLayerOutputSlot(const V1_0::Operation& operation,
+                                                                    uint32_t outputIndex,
+                                                                    armnn::IConnectableLayer& layer)
 {
     const Operand* outputOperand = GetOutputOperand(operation, outputIndex);
 
@@ -1945,20 +4354,50 @@ bool ModelToINetworkConverter::SetupAndTrackLayerOutputSlot(const V1_0::Operatio
 
     armnn::IOutputSlot& outputSlot = layer.GetOutputSlot(outputIndex);
 
+    // The AndroidNN layout version of the output is only added if a consumer needs it
     const uint32_t operandIndex = operation.outputs[outputIndex];
-    m_OutputSlotForOperand[operandIndex] = &outputSlot;
+    m_SwizzledOutputSlotForOperand[operandIndex] = &outputSlot;
 
-    outputSlot.SetTensorInfo(GetTensorInfoForOperand(*outputOperand));
+    outputSlot.SetTensorInfo(GetSwizzledTensorInfoForOperand(*outputOperand));
+
+    return true;
+}
+
+bool ModelToINetworkConverter::AliasOperand(const V1_0::Operation& operation, uint32_t inputIndex,
+                                            uint32_t outputIndex)
+{
+    if (inputIndex >= operation.inputs.size() || outputIndex >= operation.outputs.size())
+    {
+        return Fail("%s: invalid input or output index", __func__);
+    }
+
+    const uint32_t inputOperandIndex = operation.inputs[inputIndex];
+    const uint32_t outputOperandIndex = operation.outputs[outputIndex];
+
+    // Make sure the input has been added to the network in some layout (e.g. it may be a constant)
+    if (m_OutputSlotForOperand[inputOperandIndex] == nullptr &&
+        m_SwizzledOutputSlotForOperand[inputOperandIndex] == nullptr &&
+        !ConvertToLayerInputHandle(operation, inputIndex).IsValid())
+    {
+        return Fail("%s: Could not read input %u", __func__, inputIndex);
+    }
+
+    // The output then shares whichever layouts of the input exist; any others are created on demand
+    m_OutputSlotForOperand[outputOperandIndex] = m_OutputSlotForOperand[inputOperandIndex];
+    m_SwizzledOutputSlotForOperand[outputOperandIndex] = m_SwizzledOutputSlotForOperand[inputOperandIndex];
 
     return true;
 }
 
 bool ModelToINetworkConverter::IsOperationSupported(uint32_t operationIndex) const
 {
-    std::map<uint32_t, bool>::const_iterator it = m_OperationSupported.find(operationIndex);
-    assert(it != m_OperationSupported.end());
-    return it->second;
+    assert(operationIndex < m_OperationSupported.size());
+    return m_OperationSupported[operationIndex];
 }
 
+armnn::Compute ModelToINetworkConverter::GetOperationBackend(uint32_t operationIndex) const
+{
+    return operationIndex < m_OperationBackends.size() ? m_OperationBackends[operationIndex] : m_Backends[0];
+}
 
 } // armnn_driver
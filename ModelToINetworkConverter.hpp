@@ -15,8 +15,12 @@
 #include <armnn/INetwork.hpp>
 #include <CpuExecutor.h>
 
+#include "CompactModel.hpp"
+#include "CostModel.hpp"
 #include "Utils.hpp"
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <vector>
 #include <set>
@@ -42,6 +46,11 @@ public:
     ModelToINetworkConverter(armnn::Compute compute, const V1_0::Model& model,
         const std::set<unsigned int>& forcedUnsupportedOperations);
 
+    // Layers are checked against each of the given backends in order of preference,
+    // and are supported if any of them can run them.
+    ModelToINetworkConverter(const std::vector<armnn::Compute>& backends, const V1_0::Model& model,
+        const std::set<unsigned int>& forcedUnsupportedOperations);
+
     ConversionResult GetConversionResult() const { return m_ConversionResult; }
 
     // Returns the ArmNN INetwork corresponding to the input model, if preparation went smoothly, nullptr otherwise.
@@ -49,9 +58,49 @@ public:
 
     bool IsOperationSupported(uint32_t operationIndex) const;
 
+    // Returns the least preferred backend needed by any of the layers an operation was converted to.
+    armnn::Compute GetOperationBackend(uint32_t operationIndex) const;
+
+    // Returns the number of layout conversion (permute) layers added to the network.
+    unsigned int GetNumPermuteLayers() const { return m_NumPermuteLayers; }
+
+    // Returns the estimated cost of each operation (zero for those not converted), and the data moved
+    // by layout conversions of the model outputs.
+    const std::vector<OperationCost>& GetOperationCosts() const { return m_OperationCosts; }
+    double GetOutputPermuteBytes() const { return m_OutputPermuteBytes; }
+
 private:
     void Convert();
 
+    void BuildDefUseIndex(const CompactModel& compactModel);
+
+    void FindDeadOperations(const CompactModel& compactModel);
+
+    bool IsOperationSkipped(uint32_t operationIndex) const;
+
+    void SetMergedOperationSupport();
+
+    uint32_t GetNumLiveConsumers(uint32_t operandIndex) const;
+
+    uint32_t AddOperand(const Operand& operand);
+
+    void FoldConstantOperations();
+
+    bool FoldConstantOperation(const V1_0::Operation& operation);
+
+    void FoldChannelAffineOperations();
+
+    void FuseActivations();
+
+    void CollapseReshapes();
+
+    void ApplyChannelAffineTransform(const V1_0::Operation& operation, ConstTensorPin& weightsPin,
+        ConstTensorPin& biasPin, const std::function<unsigned int(unsigned int)>& getWeightChannel) const;
+
+    void LogWeightSparsity(const char* operationName, const ConstTensorPin& weightsPin);
+
+    uint32_t AddOperandValues(const void* data, uint32_t numBytes);
+
     bool ConvertOperation(const V1_0::Operation& operation);
 
     bool ConvertAdd(const V1_0::Operation& operation);
@@ -72,6 +121,8 @@ private:
 
     bool ConvertLocalResponseNormalization(const V1_0::Operation& operation);
 
+    bool ConvertLstm(const V1_0::Operation& operation);
+
     bool ConvertL2Normalization(const V1_0::Operation& operation);
 
     bool ConvertL2Pool2d(const V1_0::Operation& operation);
@@ -121,6 +172,54 @@ private:
 
     LayerInputHandle ConvertToLayerInputHandle(const V1_0::Operation& operation, uint32_t inputIndex);
 
+    LayerInputHandle ConvertToSwizzledLayerInputHandle(const V1_0::Operation& operation, uint32_t inputIndex);
+
+    LayerInputHandle ConvertToLayerInputHandleForReshape(const V1_0::Operation& operation, uint32_t inputIndex);
+
+    LayerInputHandle ConvertToConstLayerInputHandle(const Operand& operand, uint32_t operandIndex, bool swizzled,
+        bool shareLayer = true);
+
+    bool ShouldUseSwizzledInputs(const V1_0::Operation& operation, uint32_t numInputs) const;
+
+    armnn::IOutputSlot* GetOutputSlotForOperand(uint32_t operandIndex);
+
+    armnn::IOutputSlot* GetSwizzledOutputSlotForOperand(uint32_t operandIndex);
+
+    template<typename OSlot>
+    armnn::IConnectableLayer& AddPermuteLayer(OSlot& input, const armnn::PermutationVector& mappings);
+
+    // Replaces a quantized input with one in the quantization space of the given tensor, if they differ.
+    bool RequantizeLayerInput(LayerInputHandle& input, const armnn::TensorInfo& targetInfo);
+
+    // Replaces a concatenation input with its 4-D view along the given axis (see GetConcatViewShape).
+    bool ReshapeToConcatView(LayerInputHandle& input, uint32_t concatAxis);
+
+    // Adds leading dimensions of size 1 to an input of lower rank, as broadcasting does.
+    bool ExpandToRank(LayerInputHandle& input, unsigned int rank);
+
+    // Replaces an input with its broadcast to the given shape (of the same rank), if they differ.
+    bool BroadcastLayerInput(LayerInputHandle& input, const armnn::TensorShape& shape);
+
+    // Checks whether each channel of a swizzled (NCHW) input can be repeated numReplicas times in a row,
+    // accumulating the backend needed into backendIndex.
+    bool IsChannelReplicationSupported(const armnn::TensorInfo& inputInfo, unsigned int numReplicas,
+        size_t& backendIndex) const;
+
+    // Replaces a swizzled input with one in which channel i * numReplicas + r is channel i of the input.
+    void ReplicateChannels(LayerInputHandle& input, unsigned int numReplicas);
+
+    // Checks whether a depthwise convolution of a swizzled input can run as convolutions of groups of its
+    // channels, accumulating the backend needed into backendIndex.
+    bool IsDepthwiseAsGroupedConvolutionSupported(const armnn::TensorInfo& inputInfo,
+        const armnn::TensorInfo& outputInfo, const armnn::DepthwiseConvolution2dDescriptor& desc,
+        const armnn::ConstTensor& weights, const armnn::ConstTensor& bias, size_t& backendIndex) const;
+
+    // Adds the equivalent of a depthwise convolution of a swizzled input as convolutions of groups of its
+    // channels with dense weights, connects the input and returns the layer producing the output.
+    armnn::IConnectableLayer* AddDepthwiseAsGroupedConvolution(LayerInputHandle& input,
+        const armnn::TensorInfo& outputInfo, const armnn::DepthwiseConvolution2dDescriptor& desc,
+        const armnn::ConstTensor& weights, const armnn::ConstTensor& bias);
+
     ConstTensorPin ConvertOperationInputToConstTensorPin(const V1_0::Operation& operation, uint32_t inputIndex,
         const armnn::PermutationVector& dimensionMappings = g_DontPermute,
         const armnn::TensorShape* overrideTensorShape = nullptr);
@@ -139,19 +238,73 @@ private:
     bool SetupAndTrackLayerOutputSlot(const V1_0::Operation& operation, uint32_t outputIndex,
                                       armnn::IConnectableLayer& layer);
 
+    bool SetupAndTrackOutputSlot(const V1_0::Operation& operation, uint32_t outputIndex,
+                                 armnn::IOutputSlot& outputSlot);
+
+    bool SetupAndTrackSwizzledLayerOutputSlot(const V1_0::Operation& operation, uint32_t outputIndex,
+                                              armnn::IConnectableLayer& layer);
+
+    bool AliasOperand(const V1_0::Operation& operation, uint32_t inputIndex, uint32_t outputIndex);
+
+    // Cached versions of the free functions, for operands of m_Model: each operand's TensorInfo (in the AndroidNN
+    // and ArmNN layouts) is worked out only once, however many operations use it. Can throw UnsupportedOperand.
+    armnn::TensorInfo GetTensorInfoForOperand(const Operand& operand) const;
+    armnn::TensorInfo GetSwizzledTensorInfoForOperand(const Operand& operand) const;
+
 
     // Input data
-    armnn::Compute                    m_Compute;
-    const V1_0::Model&                m_Model;
+    std::vector<armnn::Compute>       m_Backends; // in order of preference
+    V1_0::Model                       m_Model; // A copy, as the folding and fusing passes rewrite it
+    std::vector<uint8_t>              m_OperandValues; // m_Model's operandValues, which the passes append to
     const std::set<unsigned int>&     m_ForcedUnsupportedOperations;
 
     // Output data
     armnn::INetworkPtr                m_Network;
     ConversionResult                  m_ConversionResult;
-    std::map<uint32_t, bool>          m_OperationSupported;
+    std::vector<bool>                 m_OperationSupported;
+    std::vector<armnn::Compute>       m_OperationBackends;
+    std::vector<OperationCost>        m_OperationCosts;
+    double                            m_OutputPermuteBytes;
 
     // Working/intermediate data
+    // Def-use index: the operation producing each operand (-1 for none), and the operations consuming it
+    // (once per use). Kept up to date by the passes rewriting the model.
+    std::vector<int32_t>               m_OperandProducers;
+    std::vector<std::vector<uint32_t>> m_OperandConsumers;
+
+    // Each operand can be produced in the AndroidNN (NHWC) layout, the ArmNN layout (for 4D tensors), or both.
+    // The layout a tensor isn't available in is only materialised (using a permute layer) if a consumer needs it.
+    // Constant operands are recorded here too, so that each constant layer is shared by all its consumers.
     std::vector<armnn::IOutputSlot*>  m_OutputSlotForOperand;
+    std::vector<armnn::IOutputSlot*>  m_SwizzledOutputSlotForOperand;
+
+    struct OperandTensorInfos
+    {
+        bool              m_HasTensorInfo = false;
+        bool              m_HasSwizzledTensorInfo = false;
+        armnn::TensorInfo m_TensorInfo;
+        armnn::TensorInfo m_SwizzledTensorInfo;
+    };
+    mutable std::vector<OperandTensorInfos> m_OperandTensorInfos;
+    unsigned int                      m_NumPermuteLayers;
+    size_t                            m_OperationBackendIndex; // into m_Backends, for the operation being converted
+    uint32_t                          m_CurrentOperationIndex; // operation being converted, if any
+    uint64_t                          m_NumWeights;     // of the convolutions and fully connected operations,
+    uint64_t                          m_NumZeroWeights; // only counted with verbose logging
+    std::set<uint32_t>                m_DeadOperations;
+    std::set<uint32_t>                m_FoldedOperations;
+    // Merged into another operation, to which each is mapped: the producer of their input for activations and
+    // per-channel affine transforms, or the consumer of their output for reshapes
+    std::map<uint32_t, uint32_t>      m_FusedOperations;
+
+    // Per output channel scale and offset, to be applied to the weights and bias of the operation producing
+    // the operand they are keyed on (after which the output is: unscaled output * scale + offset).
+    struct ChannelAffineTransform
+    {
+        std::vector<float> m_Scales;
+        std::vector<float> m_Offsets;
+    };
+    std::map<uint32_t, ChannelAffineTransform> m_ChannelAffineTransforms;
     std::vector<android::nn::RunTimePoolInfo> m_MemPools;
 };
 
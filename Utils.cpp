@@ -12,6 +12,7 @@
 #include <boost/format.hpp>
 #include <log/log.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <fstream>
@@ -37,8 +38,60 @@ void SwizzleAndroidNn4dTensorToArmNn(const armnn::TensorShape& inTensorShape, co
     armnnUtils::Permute(armnnUtils::Permuted(inTensorShape, mappings), mappings, inputData, outputData);
 }
 
+// Returns the memory address of the model as a hex string (of at least a '0' character),
+// used to name the files dumped for it.
+std::string GetModelAddressHexString(const V1_0::Model& model)
+{
+    size_t modelAddress = uintptr_t(&model);
+    std::stringstream ss;
+    ss << std::uppercase << std::hex << std::setfill('0') << std::setw(1) << modelAddress;
+    return ss.str();
+}
+
+template <typename T>
+WeightSparsity MeasureWeightSparsity(const T* data, unsigned int numElements, T zero, unsigned int blockSize)
+{
+    WeightSparsity sparsity;
+    sparsity.m_NumElements = numElements;
+    for (unsigned int blockStart = 0; blockStart < numElements; blockStart += blockSize)
+    {
+        const unsigned int blockEnd = std::min(blockStart + blockSize, numElements);
+        unsigned int numBlockZeros = 0;
+        for (unsigned int i = blockStart; i < blockEnd; ++i)
+        {
+            numBlockZeros += data[i] == zero ? 1 : 0;
+        }
+        sparsity.m_NumZeros += numBlockZeros;
+        sparsity.m_NumZeroBlocks += numBlockZeros == blockEnd - blockStart ? 1 : 0;
+        ++sparsity.m_NumBlocks;
+    }
+    return sparsity;
+}
+
 } // anonymous namespace
 
+WeightSparsity MeasureWeightSparsity(const armnn::ConstTensor& tensor, unsigned int blockSize)
+{
+    assert(blockSize > 0);
+
+    switch (tensor.GetDataType())
+    {
+    case armnn::DataType::Float32:
+        return MeasureWeightSparsity(static_cast<const float*>(tensor.GetMemoryArea()), tensor.GetNumElements(),
+            0.0f, blockSize);
+    case armnn::DataType::QuantisedAsymm8:
+        return MeasureWeightSparsity(static_cast<const uint8_t*>(tensor.GetMemoryArea()), tensor.GetNumElements(),
+            static_cast<uint8_t>(tensor.GetInfo().GetQuantizationOffset()), blockSize);
+    default:
+    {
+        WeightSparsity sparsity;
+        sparsity.m_NumElements = tensor.GetNumElements();
+        sparsity.m_NumBlocks = (sparsity.m_NumElements + blockSize - 1) / blockSize;
+        return sparsity;
+    }
+    }
+}
+
 void SwizzleAndroidNn4dTensorToArmNn(const armnn::TensorInfo& tensor, const void* input, void* output,
                                      const armnn::PermutationVector& mappings)
 {
@@ -111,6 +164,11 @@ std::string GetOperandSummary(const Operand& operand)
         toString(operand.type);
 }
 
+bool IsVerboseLoggingEnabled()
+{
+    return android::base::GetMinimumLogSeverity() <= android::base::VERBOSE;
+}
+
 std::string GetModelSummary(const V1_0::Model& model)
 {
     std::stringstream result;
@@ -290,16 +348,10 @@ void ExportNetworkGraphToDotFile(const armnn::IOptimizedNetwork& optimizedNetwor
         return;
     }
 
-    // Get the memory address of the model and convert it to a hex string (of at least a '0' character).
-    size_t modelAddress = uintptr_t(&model);
-    std::stringstream ss;
-    ss << std::uppercase << std::hex << std::setfill('0') << std::setw(1) << modelAddress;
-    std::string modelAddressHexString = ss.str();
-
     // Set the name of the output .dot file.
     const std::string fileName = boost::str(boost::format("%1%/networkgraph_%2%.dot")
                                             % dumpDir
-                                            % modelAddressHexString);
+                                            % GetModelAddressHexString(model));
 
     ALOGV("Exporting the optimized network graph to file: %s", fileName.c_str());
 
@@ -318,4 +370,33 @@ void ExportNetworkGraphToDotFile(const armnn::IOptimizedNetwork& optimizedNetwor
         ALOGW("An error occurred when writing to file %s", fileName.c_str());
     }
 }
+
+void ExportCostReportToFile(const std::string& report,
+                            const std::string& dumpDir,
+                            const V1_0::Model& model)
+{
+    // The dump directory must exist in advance.
+    if (dumpDir.empty())
+    {
+        return;
+    }
+
+    // Name the report after the model, like the network graph it accompanies.
+    const std::string fileName = boost::str(boost::format("%1%/costreport_%2%.txt")
+                                            % dumpDir
+                                            % GetModelAddressHexString(model));
+
+    ALOGV("Exporting the model cost report to file: %s", fileName.c_str());
+
+    std::ofstream fileStream;
+    fileStream.open(fileName, std::ofstream::out | std::ofstream::trunc);
+
+    if (!fileStream.good())
+    {
+        ALOGW("Could not open file %s for writing", fileName.c_str());
+        return;
+    }
+
+    fileStream << report;
+}
 } // namespace armnn_driver
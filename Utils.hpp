@@ -35,6 +35,23 @@ public:
 void SwizzleAndroidNn4dTensorToArmNn(const armnn::TensorInfo& tensor, const void* input, void* output,
                                      const armnn::PermutationVector& mappings);
 
+/// The number of a weight tensor's elements which are zero, and of its blocks of consecutive elements
+/// which are entirely zero (the work a block-sparse kernel could skip).
+struct WeightSparsity
+{
+    unsigned int m_NumElements   = 0;
+    unsigned int m_NumZeros      = 0;
+    unsigned int m_NumBlocks     = 0;
+    unsigned int m_NumZeroBlocks = 0;
+
+    float GetZeroFraction() const { return m_NumElements > 0 ? float(m_NumZeros) / m_NumElements : 0.0f; }
+    float GetZeroBlockFraction() const { return m_NumBlocks > 0 ? float(m_NumZeroBlocks) / m_NumBlocks : 0.0f; }
+};
+
+/// Measures the sparsity of a Float32 or QuantisedAsymm8 tensor (where zero is the quantization offset), in blocks
+/// of @a blockSize elements in memory order. Tensors of other types are reported as dense.
+WeightSparsity MeasureWeightSparsity(const armnn::ConstTensor& tensor, unsigned int blockSize);
+
 /// Returns a pointer to a specific location in a pool
 void* GetMemoryFromPool(DataLocation location,
                         const std::vector<android::nn::RunTimePoolInfo>& memPools);
@@ -45,6 +62,10 @@ armnn::TensorInfo GetTensorInfoForOperand(const Operand& operand);
 std::string GetOperandSummary(const Operand& operand);
 std::string GetModelSummary(const V1_0::Model& model);
 
+/// Returns true if verbose logging has been turned on (see DriverOptions). The model summary is proportional
+/// to the size of the model, so should only be built when it will be logged.
+bool IsVerboseLoggingEnabled();
+
 void DumpTensor(const std::string& dumpDir,
     const std::string& requestName,
     const std::string& tensorName,
@@ -53,4 +74,9 @@ void DumpTensor(const std::string& dumpDir,
 void ExportNetworkGraphToDotFile(const armnn::IOptimizedNetwork& optimizedNetwork,
                                  const std::string& dumpDir,
                                  const V1_0::Model& model);
+
+/// Writes @a report (see GetCostReport) next to the network graph exported for the same model.
+void ExportCostReportToFile(const std::string& report,
+                            const std::string& dumpDir,
+                            const V1_0::Model& model);
 }
@@ -0,0 +1,194 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "WeightCompression.hpp"
+
+#include "CostModel.hpp"
+#include "Utils.hpp"
+
+#include <boost/format.hpp>
+#include <log/log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace armnn_driver
+{
+
+namespace
+{
+
+// A fixed linear congruential sequence in [-1, 1], so that reports are reproducible
+std::vector<float> CreateTestInput(unsigned int size)
+{
+    std::vector<float> input(size);
+    uint32_t state = 12345u;
+    for (float& value : input)
+    {
+        state = state * 1664525u + 1013904223u;
+        value = static_cast<float>(state >> 8) / static_cast<float>(1u << 23) - 1.0f;
+    }
+    return input;
+}
+
+const float* GetConstantFloatValues(const V1_0::Model& model, const Operand& operand,
+                                    const std::vector<android::nn::RunTimePoolInfo>& memPools)
+{
+    switch (operand.lifetime)
+    {
+        case OperandLifeTime::CONSTANT_COPY:
+            return reinterpret_cast<const float*>(&model.operandValues[operand.location.offset]);
+        case OperandLifeTime::CONSTANT_REFERENCE:
+            return static_cast<const float*>(GetMemoryFromPool(operand.location, memPools));
+        default:
+            return nullptr;
+    }
+}
+
+} // anonymous namespace
+
+RowQuantizedWeights QuantizeRowsToInt8(const float* weights, unsigned int numRows, unsigned int rowSize)
+{
+    RowQuantizedWeights quantized;
+    quantized.m_Values.resize(static_cast<size_t>(numRows) * rowSize);
+    quantized.m_RowScales.resize(numRows);
+
+    for (unsigned int row = 0; row < numRows; ++row)
+    {
+        const float* rowWeights = weights + static_cast<size_t>(row) * rowSize;
+        float maxMagnitude = 0.0f;
+        for (unsigned int i = 0; i < rowSize; ++i)
+        {
+            maxMagnitude = std::max(maxMagnitude, std::fabs(rowWeights[i]));
+        }
+
+        // An all-zero row is represented exactly whatever the scale
+        const float scale = maxMagnitude > 0.0f ? maxMagnitude / 127.0f : 1.0f;
+        quantized.m_RowScales[row] = scale;
+
+        int8_t* rowValues = quantized.m_Values.data() + static_cast<size_t>(row) * rowSize;
+        for (unsigned int i = 0; i < rowSize; ++i)
+        {
+            const float value = std::round(rowWeights[i] / scale);
+            rowValues[i] = static_cast<int8_t>(std::min(127.0f, std::max(-127.0f, value)));
+        }
+    }
+
+    return quantized;
+}
+
+void DequantizeRows(const RowQuantizedWeights& weights, unsigned int rowSize, float* output)
+{
+    for (size_t i = 0; i < weights.m_Values.size(); ++i)
+    {
+        output[i] = weights.m_Values[i] * weights.m_RowScales[i / rowSize];
+    }
+}
+
+std::vector<WeightCompressionEstimate> EstimateFullyConnectedWeightCompression(const V1_0::Model& model,
+                                                                               double minWeightBytes)
+{
+    std::vector<WeightCompressionEstimate> estimates;
+
+    std::vector<android::nn::RunTimePoolInfo> memPools;
+    if (!setRunTimePoolInfosFromHidlMemories(&memPools, model.pools))
+    {
+        ALOGW("%s: Setting of run time pool infos from Hidl Memories has failed.", __func__);
+        return estimates;
+    }
+
+    for (uint32_t operationIdx = 0; operationIdx < model.operations.size(); ++operationIdx)
+    {
+        const V1_0::Operation& operation = model.operations[operationIdx];
+        if (operation.type != V1_0::OperationType::FULLY_CONNECTED || operation.inputs.size() < 2)
+        {
+            continue;
+        }
+
+        // Weights are [ num units, input size ]
+        const Operand& weightsOperand = model.operands[operation.inputs[1]];
+        if (weightsOperand.type != OperandType::TENSOR_FLOAT32 ||
+            weightsOperand.dimensions.size() != 2 ||
+            GetOperandSizeInBytes(weightsOperand) < minWeightBytes)
+        {
+            continue;
+        }
+
+        const float* weights = GetConstantFloatValues(model, weightsOperand, memPools);
+        if (weights == nullptr)
+        {
+            continue;
+        }
+
+        const unsigned int numUnits = weightsOperand.dimensions[0];
+        const unsigned int inputSize = weightsOperand.dimensions[1];
+
+        const RowQuantizedWeights quantized = QuantizeRowsToInt8(weights, numUnits, inputSize);
+        std::vector<float> dequantized(quantized.m_Values.size());
+        DequantizeRows(quantized, inputSize, dequantized.data());
+
+        WeightCompressionEstimate estimate;
+        estimate.m_OperationIndex = operationIdx;
+        estimate.m_FloatBytes = GetOperandSizeInBytes(weightsOperand);
+        estimate.m_CompressedBytes = static_cast<double>(quantized.m_Values.size()) +
+                                     quantized.m_RowScales.size() * sizeof(float);
+
+        const std::vector<float> input = CreateTestInput(inputSize);
+        for (unsigned int unit = 0; unit < numUnits; ++unit)
+        {
+            const size_t rowStart = static_cast<size_t>(unit) * inputSize;
+            double output = 0.0;
+            double approximateOutput = 0.0;
+            for (unsigned int i = 0; i < inputSize; ++i)
+            {
+                const float weight = weights[rowStart + i];
+                const float approximateWeight = dequantized[rowStart + i];
+                estimate.m_MaxWeightError = std::max(estimate.m_MaxWeightError, std::fabs(weight - approximateWeight));
+                output += static_cast<double>(weight) * input[i];
+                approximateOutput += static_cast<double>(approximateWeight) * input[i];
+            }
+            estimate.m_MaxOutputError = std::max(estimate.m_MaxOutputError,
+                                                 static_cast<float>(std::fabs(output - approximateOutput)));
+            estimate.m_MaxOutput = std::max(estimate.m_MaxOutput, static_cast<float>(std::fabs(output)));
+        }
+
+        estimates.push_back(estimate);
+    }
+
+    return estimates;
+}
+
+std::string GetWeightCompressionReport(const V1_0::Model& model,
+                                       const std::vector<WeightCompressionEstimate>& estimates)
+{
+    double totalFloatBytes = 0.0;
+    double totalCompressedBytes = 0.0;
+
+    std::stringstream report;
+    for (const WeightCompressionEstimate& estimate : estimates)
+    {
+        totalFloatBytes += estimate.m_FloatBytes;
+        totalCompressedBytes += estimate.m_CompressedBytes;
+
+        const float relativeError = estimate.m_MaxOutput > 0.0f ? estimate.m_MaxOutputError / estimate.m_MaxOutput
+                                                                : 0.0f;
+        report << "  " << estimate.m_OperationIndex << " "
+               << toString(model.operations[estimate.m_OperationIndex].type) << ": "
+               << boost::str(boost::format("weights %.1f KB -> %.1f KB, max weight error %g, "
+                                           "max output error %g (%.4f%% of max output)")
+                             % (estimate.m_FloatBytes / 1024.0) % (estimate.m_CompressedBytes / 1024.0)
+                             % estimate.m_MaxWeightError % estimate.m_MaxOutputError % (100.0f * relativeError))
+               << std::endl;
+    }
+
+    return boost::str(boost::format("Int8 weights for %u fully connected operation(s): %.1f KB -> %.1f KB\n")
+                      % estimates.size() % (totalFloatBytes / 1024.0) % (totalCompressedBytes / 1024.0))
+           + report.str();
+}
+
+}
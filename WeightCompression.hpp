@@ -0,0 +1,54 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#pragma once
+
+#include "HalInterfaces.h"
+
+#include "ArmnnDriver.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// A weight matrix stored as int8 values with a float scale per row: row r, column c is
+/// m_Values[r * rowSize + c] * m_RowScales[r].
+struct RowQuantizedWeights
+{
+    std::vector<int8_t> m_Values;
+    std::vector<float>  m_RowScales;
+};
+
+/// Quantizes each row of a [numRows, rowSize] float matrix symmetrically to int8, scaled by its largest magnitude.
+RowQuantizedWeights QuantizeRowsToInt8(const float* weights, unsigned int numRows, unsigned int rowSize);
+
+/// Writes the float values represented by @a weights to @a output, which holds numRows * rowSize elements.
+void DequantizeRows(const RowQuantizedWeights& weights, unsigned int rowSize, float* output);
+
+/// The effect of storing the weights of a FULLY_CONNECTED operation as row-quantized int8.
+struct WeightCompressionEstimate
+{
+    uint32_t m_OperationIndex  = 0;
+    double   m_FloatBytes      = 0.0; ///< Size of the float32 weights
+    double   m_CompressedBytes = 0.0; ///< Size of the int8 weights and their row scales
+    float    m_MaxWeightError  = 0.0f; ///< Largest absolute difference between a weight and its int8 approximation
+    float    m_MaxOutputError  = 0.0f; ///< Largest absolute difference of the outputs on the test input
+    float    m_MaxOutput       = 0.0f; ///< Largest absolute output on the test input, to put the error in proportion
+};
+
+/// Estimates the savings and accuracy of storing the float32 weights of the model's FULLY_CONNECTED operations
+/// as row-quantized int8, for those whose weights are at least @a minWeightBytes. The outputs are compared on a
+/// fixed pseudo-random input in [-1, 1], before the bias and activation which are unaffected.
+std::vector<WeightCompressionEstimate> EstimateFullyConnectedWeightCompression(const V1_0::Model& model,
+                                                                               double minWeightBytes);
+
+/// Returns a human-readable report of the estimates, one line per operation plus a total.
+std::string GetWeightCompressionReport(const V1_0::Model& model,
+                                       const std::vector<WeightCompressionEstimate>& estimates);
+
+}
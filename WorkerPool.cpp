@@ -0,0 +1,71 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "WorkerPool.hpp"
+
+#include <log/log.h>
+
+namespace armnn_driver
+{
+
+WorkerPool::WorkerPool(unsigned int numWorkers)
+    : m_Exit(false)
+{
+    ALOGV("WorkerPool::WorkerPool(%u)", numWorkers);
+    m_Workers.reserve(numWorkers);
+    for (unsigned int i = 0; i < numWorkers; ++i)
+    {
+        m_Workers.emplace_back(&WorkerPool::Process, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    ALOGV("WorkerPool::~WorkerPool()");
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Exit = true;
+    }
+    m_Cv.notify_all();
+
+    for (std::thread& worker : m_Workers)
+    {
+        worker.join();
+    }
+}
+
+void WorkerPool::Post(std::function<void()> task)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Queue.push(std::move(task));
+    }
+    m_Cv.notify_one();
+}
+
+void WorkerPool::Process()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            // Wait for a task to be posted, finishing any remaining ones before exiting
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Cv.wait(lock, [this] { return m_Exit || !m_Queue.empty(); });
+            if (m_Queue.empty())
+            {
+                return;
+            }
+            task = std::move(m_Queue.front());
+            m_Queue.pop();
+        }
+
+        task();
+    }
+}
+
+} // namespace armnn_driver
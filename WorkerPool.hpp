@@ -0,0 +1,47 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// A fixed number of threads running the tasks posted to them, in the order they were posted.
+class WorkerPool
+{
+public:
+    /// Constructor creates the threads
+    explicit WorkerPool(unsigned int numWorkers);
+
+    /// Destructor waits for the tasks already posted, then terminates the threads
+    ~WorkerPool();
+
+    unsigned int GetNumWorkers() const { return static_cast<unsigned int>(m_Workers.size()); }
+
+    /// Queues a task to be run by the first free worker.
+    void Post(std::function<void()> task);
+
+private:
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// Entry point for the worker threads
+    void Process();
+
+    std::vector<std::thread> m_Workers;
+    std::queue<std::function<void()>> m_Queue;
+    std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    bool m_Exit;
+};
+
+} // namespace armnn_driver
@@ -29,14 +29,19 @@ LOCAL_CFLAGS := \
 LOCAL_SRC_FILES :=	\
 	Tests.cpp \
 	UtilsTests.cpp \
+	BranchPartitioner.cpp \
+	CompactModel.cpp \
 	Concurrent.cpp  \
+	CostModel.cpp \
 	Convolution2D.cpp  \
 	FullyConnected.cpp  \
 	GenericLayerTests.cpp \
+	Lstm.cpp \
 	DriverTestHelpers.cpp \
 	SystemProperties.cpp \
 	Merger.cpp \
-	TestTensor.cpp
+	TestTensor.cpp \
+	WeightCompression.cpp
 
 LOCAL_STATIC_LIBRARIES := \
 	libarmnn-driver \
@@ -0,0 +1,186 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+#include "DriverTestHelpers.hpp"
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include "../BranchPartitioner.hpp"
+#include "../ModelToINetworkConverter.hpp"
+
+BOOST_AUTO_TEST_SUITE(BranchPartitionerTests)
+
+using namespace armnn_driver;
+using namespace driverTestHelpers;
+
+namespace
+{
+
+// input -> RELU -> temp1, then RELU(temp1) -> temp2 and RELU(temp1) -> temp3, then ADD(temp2, temp3) -> output
+V1_0::Model CreateForkJoinModel()
+{
+    V1_0::Model model = {};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+    AddIntOperand(model, 0);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+
+    model.operations.resize(4);
+    model.operations[0].type    = V1_0::OperationType::RELU;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0};
+    model.operations[0].outputs = hidl_vec<uint32_t>{1};
+
+    model.operations[1].type    = V1_0::OperationType::RELU;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{1};
+    model.operations[1].outputs = hidl_vec<uint32_t>{2};
+
+    model.operations[2].type    = V1_0::OperationType::RELU;
+    model.operations[2].inputs  = hidl_vec<uint32_t>{1};
+    model.operations[2].outputs = hidl_vec<uint32_t>{3};
+
+    model.operations[3].type    = V1_0::OperationType::ADD;
+    model.operations[3].inputs  = hidl_vec<uint32_t>{2, 3, 4};
+    model.operations[3].outputs = hidl_vec<uint32_t>{5};
+
+    return model;
+}
+
+// input -> RELU -> temp1, which is read by three branches: a single RELU, and two chains of two RELUs. The first
+// two branches are added together, then the third is added to their sum.
+V1_0::Model CreateThreeWayForkModel()
+{
+    V1_0::Model model = {};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+    for (uint32_t i = 1; i <= 7; i++)
+    {
+        AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+    }
+    AddIntOperand(model, 0);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+
+    const uint32_t reluInputs[]  = {0, 1, 1, 3, 1, 5};
+    const uint32_t reluOutputs[] = {1, 2, 3, 4, 5, 6};
+
+    model.operations.resize(8);
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        model.operations[i].type    = V1_0::OperationType::RELU;
+        model.operations[i].inputs  = hidl_vec<uint32_t>{reluInputs[i]};
+        model.operations[i].outputs = hidl_vec<uint32_t>{reluOutputs[i]};
+    }
+
+    model.operations[6].type    = V1_0::OperationType::ADD;
+    model.operations[6].inputs  = hidl_vec<uint32_t>{2, 4, 8};
+    model.operations[6].outputs = hidl_vec<uint32_t>{7};
+
+    model.operations[7].type    = V1_0::OperationType::ADD;
+    model.operations[7].inputs  = hidl_vec<uint32_t>{7, 6, 8};
+    model.operations[7].outputs = hidl_vec<uint32_t>{9};
+
+    return model;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(ForkAndJoinArePartitioned)
+{
+    const V1_0::Model model = CreateForkJoinModel();
+    const std::vector<ModelPartition> partitions = PartitionModelAtBranches(model, 0.0);
+
+    BOOST_TEST(partitions.size() == 4);
+    if (partitions.size() != 4)
+    {
+        return;
+    }
+
+    // The first RELU feeds both branches
+    BOOST_TEST(partitions[0].m_Model.operations.size() == 1);
+    BOOST_TEST(partitions[0].m_Model.inputIndexes.size() == 1);
+    BOOST_TEST(partitions[0].m_Model.inputIndexes[0] == 0);
+    BOOST_TEST(partitions[0].m_Model.outputIndexes.size() == 1);
+    BOOST_TEST(partitions[0].m_Model.outputIndexes[0] == 1);
+    BOOST_TEST(partitions[0].m_Dependencies.empty());
+
+    // The branches only depend on it, not on each other
+    for (size_t i = 1; i <= 2; i++)
+    {
+        BOOST_TEST(partitions[i].m_Model.inputIndexes.size() == 1);
+        BOOST_TEST(partitions[i].m_Model.inputIndexes[0] == 1);
+        BOOST_TEST((partitions[i].m_Model.operands[1].lifetime == OperandLifeTime::MODEL_INPUT));
+        BOOST_TEST((partitions[i].m_Dependencies == std::vector<uint32_t>{0}));
+    }
+    BOOST_TEST(partitions[1].m_Model.outputIndexes[0] == 2);
+    BOOST_TEST(partitions[2].m_Model.outputIndexes[0] == 3);
+
+    // The ADD joins them, and produces the output of the whole model
+    BOOST_TEST(partitions[3].m_Model.inputIndexes.size() == 2);
+    BOOST_TEST(partitions[3].m_Model.outputIndexes.size() == 1);
+    BOOST_TEST(partitions[3].m_Model.outputIndexes[0] == 5);
+    BOOST_TEST((partitions[3].m_Dependencies == std::vector<uint32_t>{1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(SmallBranchesAreNotPartitioned)
+{
+    // Every branch is below the threshold, so they end up merged together
+    const V1_0::Model model = CreateForkJoinModel();
+    BOOST_TEST(PartitionModelAtBranches(model, 1e12).empty());
+}
+
+BOOST_AUTO_TEST_CASE(ChainIsNotPartitioned)
+{
+    V1_0::Model model = {};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 8, 8, 4});
+
+    model.operations.resize(2);
+    model.operations[0].type    = V1_0::OperationType::RELU;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0};
+    model.operations[0].outputs = hidl_vec<uint32_t>{1};
+
+    model.operations[1].type    = V1_0::OperationType::RELU6;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{1};
+    model.operations[1].outputs = hidl_vec<uint32_t>{2};
+
+    BOOST_TEST(PartitionModelAtBranches(model, 0.0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(SmallBranchIsMergedIntoItsForkPoint)
+{
+    // Each RELU is 256 FLOPs, so the single RELU branch is merged into the RELU it forks from, but the two chains
+    // of two are big enough to stay apart
+    const V1_0::Model model = CreateThreeWayForkModel();
+    const std::vector<ModelPartition> partitions = PartitionModelAtBranches(model, 300.0);
+
+    BOOST_TEST(partitions.size() == 5);
+    if (partitions.size() != 5)
+    {
+        return;
+    }
+
+    // The fork point is still read by the other branches, so it is an output of the partition, and read within it
+    const V1_0::Model& forkPartition = partitions[0].m_Model;
+    BOOST_TEST(forkPartition.operations.size() == 2);
+    BOOST_TEST((std::vector<uint32_t>(forkPartition.outputIndexes.begin(), forkPartition.outputIndexes.end()) ==
+                std::vector<uint32_t>{1, 2}));
+    BOOST_TEST((forkPartition.operands[1].lifetime == OperandLifeTime::MODEL_OUTPUT));
+    BOOST_TEST((forkPartition.operations[1].inputs == hidl_vec<uint32_t>{1}));
+
+    BOOST_TEST((partitions[1].m_Dependencies == std::vector<uint32_t>{0}));
+    BOOST_TEST((partitions[2].m_Dependencies == std::vector<uint32_t>{0}));
+
+    // The partition still converts, with the merged branch reading the model output its producer added
+    std::set<unsigned int> unsupportedOperations;
+    ModelToINetworkConverter converter(armnn::Compute::CpuRef, forkPartition, unsupportedOperations);
+    BOOST_TEST((converter.GetConversionResult() == ConversionResult::Success));
+    BOOST_TEST(converter.IsOperationSupported(0));
+    BOOST_TEST(converter.IsOperationSupported(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
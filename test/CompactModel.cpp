@@ -0,0 +1,68 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+#include "DriverTestHelpers.hpp"
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include "../CompactModel.hpp"
+
+BOOST_AUTO_TEST_SUITE(CompactModelTests)
+
+using namespace armnn_driver;
+using namespace driverTestHelpers;
+
+BOOST_AUTO_TEST_CASE(OperandsAndAdjacency)
+{
+    // input -> RELU -> temp -> ADD(temp, temp) -> output, plus a constant which is never used
+    V1_0::Model model = {};
+
+    float constant[] = {1, 2, 3};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 3});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2, 2, 3});
+    AddIntOperand(model, 0);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 3});
+    AddTensorOperand(model, hidl_vec<uint32_t>{3}, constant);
+
+    model.operations.resize(2);
+    model.operations[0].type    = V1_0::OperationType::RELU;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0};
+    model.operations[0].outputs = hidl_vec<uint32_t>{1};
+
+    model.operations[1].type    = V1_0::OperationType::ADD;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{1, 1, 2};
+    model.operations[1].outputs = hidl_vec<uint32_t>{3};
+
+    const CompactModel compactModel(model);
+
+    BOOST_TEST(compactModel.GetNumOperands() == 5);
+    BOOST_TEST(compactModel.GetNumOperations() == 2);
+
+    BOOST_TEST(compactModel.GetOperandRank(0) == 4);
+    BOOST_TEST(compactModel.GetOperandRank(2) == 0);
+    BOOST_TEST(compactModel.GetOperandRank(4) == 1);
+    BOOST_TEST(compactModel.GetOperandDimensions(4)[0] == 3);
+    BOOST_TEST(compactModel.GetOperandNumElements(1) == 12);
+    BOOST_TEST(compactModel.IsOperandConstant(4));
+    BOOST_TEST(!compactModel.IsOperandConstant(1));
+
+    BOOST_TEST(compactModel.GetProducer(0) == -1);
+    BOOST_TEST(compactModel.GetProducer(1) == 0);
+    BOOST_TEST(compactModel.GetProducer(3) == 1);
+
+    // The ADD uses the RELU's output twice
+    const IndexRange consumers = compactModel.GetConsumers(1);
+    BOOST_TEST(consumers.size() == 2);
+    BOOST_TEST(consumers[0] == 1);
+    BOOST_TEST(consumers[1] == 1);
+    BOOST_TEST(compactModel.GetConsumers(4).empty());
+
+    BOOST_TEST((int)compactModel.GetOperationType(1) == (int)V1_0::OperationType::ADD);
+    BOOST_TEST(compactModel.GetOperationInputs(1).size() == 3);
+    BOOST_TEST(compactModel.GetOperationInputs(1)[2] == 2);
+    BOOST_TEST(compactModel.GetOperationOutputs(0)[0] == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,11 @@
 #include <boost/test/unit_test.hpp>
 #include <log/log.h>
 
+#include "../ArmnnPreparedModel.hpp"
+#include "../BranchPartitioner.hpp"
+#include "../ModelToINetworkConverter.hpp"
+#include "../WorkerPool.hpp"
+
 BOOST_AUTO_TEST_SUITE(ConcurrentDriverTests)
 
 using ArmnnDriver = armnn_driver::ArmnnDriver;
@@ -13,6 +18,82 @@ using DriverOptions = armnn_driver::DriverOptions;
 using namespace android::nn;
 using namespace driverTestHelpers;
 
+namespace
+{
+
+// Two 1x1 convolutions of the input, joined by an ADD: ch0 = (x0 + x1) + 2 * x0, ch1 = (x0 - x1) + x1
+V1_0::Model CreateConvForkJoinModel()
+{
+    V1_0::Model model = {};
+
+    float weightsA[] = {1, 1, 1, -1};
+    float weightsB[] = {2, 0, 0, 1};
+    float bias[]     = {0, 0};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1, 1, 2}, weightsA);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, bias);
+    AddIntOperand(model, (int32_t)android::nn::kPaddingValid); // padding
+    AddIntOperand(model, 1); // stride x
+    AddIntOperand(model, 1); // stride y
+    AddIntOperand(model, 0); // no activation
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1, 1, 2}, weightsB);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, bias);
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+
+    model.operations.resize(3);
+    model.operations[0].type    = V1_0::OperationType::CONV_2D;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3, 4, 5, 6};
+    model.operations[0].outputs = hidl_vec<uint32_t>{7};
+    model.operations[1].type    = V1_0::OperationType::CONV_2D;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{0, 8, 9, 3, 4, 5, 6};
+    model.operations[1].outputs = hidl_vec<uint32_t>{10};
+    model.operations[2].type    = V1_0::OperationType::ADD;
+    model.operations[2].inputs  = hidl_vec<uint32_t>{7, 10, 6};
+    model.operations[2].outputs = hidl_vec<uint32_t>{11};
+
+    return model;
+}
+
+// Runs the fork/join model on a fixed input, returning the status the execution finished with
+ErrorStatus ExecuteConvForkJoinModel(android::sp<IPreparedModel> preparedModel, std::vector<float>& outputValues)
+{
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = 8 * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = 8 * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    float indata[] = {1, 2, 3, -4, -5, 6, 0, 7};
+    AddPoolAndSetData(8, request, indata);
+    android::sp<IMemory> outMemory = AddPoolAndGetData(8, request);
+
+    android::sp<ExecutionCallback> cb = ExecuteNoWait(preparedModel, request);
+    cb->wait();
+
+    const float* outdata = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+    outputValues.assign(outdata, outdata + 8);
+    return cb->GetErrorStatus();
+}
+
+} // namespace <anonymous>
+
 // Add our own test for concurrent execution
 // The main point of this test is to check that multiple requests can be
 // executed without waiting for the callback from previous execution.
@@ -106,4 +187,106 @@ BOOST_AUTO_TEST_CASE(ConcurrentExecute)
     ALOGI("ConcurrentExecute: exit");
 }
 
+BOOST_AUTO_TEST_CASE(ConcurrentBranchesMatchSingleNetwork)
+{
+    // The branches are far too small to be worth running as separate networks by default, so lower the threshold
+    const V1_0::Model model = CreateConvForkJoinModel();
+
+    char arg0[] = "armnn-driver";
+    char arg1[] = "--compute";
+    char arg2[] = "CpuRef";
+    char arg3[] = "--concurrent-branches";
+    char arg4[] = "2";
+    char arg5[] = "--min-branch-flops";
+    char arg6[] = "0";
+    char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6};
+    auto concurrentDriver = std::make_unique<ArmnnDriver>(DriverOptions(7, argv));
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    android::sp<IPreparedModel> concurrentPreparedModel = PrepareModel(model, *concurrentDriver);
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    // Each convolution and the ADD joining them is a network of its own
+    BOOST_TEST(static_cast<armnn_driver::ArmnnPreparedModel*>(concurrentPreparedModel.get())->GetNumNetworks() == 3);
+    BOOST_TEST(static_cast<armnn_driver::ArmnnPreparedModel*>(preparedModel.get())->GetNumNetworks() == 1);
+
+    std::vector<float> concurrentOutput;
+    std::vector<float> output;
+    BOOST_TEST(ExecuteConvForkJoinModel(concurrentPreparedModel, concurrentOutput) == ErrorStatus::NONE);
+    BOOST_TEST(ExecuteConvForkJoinModel(preparedModel, output) == ErrorStatus::NONE);
+
+    BOOST_TEST(concurrentOutput == output);
+    const std::vector<float> expectedOutput = {5, 1, 5, 3, -9, -5, 7, 0};
+    BOOST_TEST(concurrentOutput == expectedOutput);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentBranchEnqueueMatchesSingleNetwork)
+{
+    const V1_0::Model model = CreateConvForkJoinModel();
+
+    char arg0[] = "armnn-driver";
+    char arg1[] = "--compute";
+    char arg2[] = "CpuRef";
+    char arg3[] = "--concurrent-branches";
+    char arg4[] = "2";
+    char arg5[] = "--min-branch-flops";
+    char arg6[] = "0";
+    char arg7[] = "--concurrent-branch-enqueue";
+    char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7};
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(8, argv));
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+    BOOST_TEST(static_cast<armnn_driver::ArmnnPreparedModel*>(preparedModel.get())->GetNumNetworks() == 3);
+
+    std::vector<float> output;
+    BOOST_TEST(ExecuteConvForkJoinModel(preparedModel, output) == ErrorStatus::NONE);
+    const std::vector<float> expectedOutput = {5, 1, 5, 3, -9, -5, 7, 0};
+    BOOST_TEST(output == expectedOutput);
+}
+
+BOOST_AUTO_TEST_CASE(FailingBranchFailsTheRequest)
+{
+    const V1_0::Model model = CreateConvForkJoinModel();
+    const std::vector<armnn_driver::ModelPartition> partitions = armnn_driver::PartitionModelAtBranches(model, 0.0);
+    BOOST_TEST(partitions.size() == 3);
+
+    // Load each partition as the driver does for --concurrent-branches
+    armnn::IRuntime::CreationOptions options(armnn::Compute::CpuRef);
+    armnn::IRuntimePtr runtime = armnn::IRuntime::Create(options);
+
+    std::set<unsigned int> unsupportedOperations;
+    std::vector<armnn_driver::SubNetwork> subNetworks;
+    for (const armnn_driver::ModelPartition& partition : partitions)
+    {
+        armnn_driver::ModelToINetworkConverter converter(armnn::Compute::CpuRef, partition.m_Model,
+            unsupportedOperations);
+        BOOST_TEST((converter.GetConversionResult() == armnn_driver::ConversionResult::Success));
+
+        armnn_driver::SubNetwork subNetwork;
+        armnn::IOptimizedNetworkPtr optNet = armnn::Optimize(*converter.GetINetwork(), runtime->GetDeviceSpec());
+        BOOST_TEST((runtime->LoadNetwork(subNetwork.m_NetworkId, std::move(optNet)) == armnn::Status::Success));
+
+        subNetwork.m_InputOperands.assign(partition.m_Model.inputIndexes.begin(),
+                                          partition.m_Model.inputIndexes.end());
+        subNetwork.m_OutputOperands.assign(partition.m_Model.outputIndexes.begin(),
+                                           partition.m_Model.outputIndexes.end());
+        subNetwork.m_Dependencies = partition.m_Dependencies;
+        subNetworks.push_back(std::move(subNetwork));
+    }
+
+    // Bind nothing to the first branch's input, so that ArmNN rejects it when it is run. The ADD joining the
+    // branches must then never be started, and the request must finish with an error.
+    subNetworks[0].m_InputOperands.clear();
+
+    const std::string requestInputsAndOutputsDumpDir;
+    {
+        android::sp<IPreparedModel> preparedModel = new armnn_driver::ArmnnPreparedModel(std::move(subNetworks),
+            runtime.get(), model, requestInputsAndOutputsDumpDir, std::make_shared<armnn_driver::WorkerPool>(2),
+            std::make_shared<std::mutex>());
+
+        std::vector<float> output;
+        BOOST_TEST(ExecuteConvForkJoinModel(preparedModel, output) == ErrorStatus::GENERAL_FAILURE);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
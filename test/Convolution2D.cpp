@@ -3,6 +3,7 @@
 // See LICENSE file in the project root for full license information.
 //
 #include "DriverTestHelpers.hpp"
+#include "../ModelToINetworkConverter.hpp"
 #include <boost/test/unit_test.hpp>
 #include <log/log.h>
 
@@ -107,4 +108,429 @@ BOOST_AUTO_TEST_CASE(ConvSamePadding)
     PaddingTestImpl(android::nn::kPaddingSame);
 }
 
+BOOST_AUTO_TEST_CASE(ConvReluConvStaysInArmnnLayout)
+{
+    // conv -> relu -> conv: only the network input and output should need permuting
+    V1_0::Model model = {};
+
+    float weightValue[] = {2};
+    float biasValue[]   = {-1};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 1});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 1, 1, 1}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, biasValue);
+    AddIntOperand(model, (int32_t)android::nn::kPaddingValid); // padding
+    AddIntOperand(model, 1); // stride x
+    AddIntOperand(model, 1); // stride y
+    AddIntOperand(model, 0); // no activation
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2, 2, 1});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2, 2, 1});
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 1});
+
+    model.operations.resize(3);
+    model.operations[0].type = V1_0::OperationType::CONV_2D;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3, 4, 5, 6};
+    model.operations[0].outputs = hidl_vec<uint32_t>{7};
+    model.operations[1].type = V1_0::OperationType::RELU;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{7};
+    model.operations[1].outputs = hidl_vec<uint32_t>{8};
+    model.operations[2].type = V1_0::OperationType::CONV_2D;
+    model.operations[2].inputs  = hidl_vec<uint32_t>{8, 1, 2, 3, 4, 5, 6};
+    model.operations[2].outputs = hidl_vec<uint32_t>{9};
+
+    std::set<unsigned int> unsupportedOperations;
+    armnn_driver::ModelToINetworkConverter converter(armnn::Compute::CpuRef, model, unsupportedOperations);
+    BOOST_TEST((converter.GetConversionResult() == armnn_driver::ConversionResult::Success));
+    BOOST_TEST(converter.GetNumPermuteLayers() == 2);
+
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    // construct the request
+    DataLocation inloc    = {};
+    inloc.poolIndex       = 0;
+    inloc.offset          = 0;
+    inloc.length          = 4 * sizeof(float);
+    RequestArgument input = {};
+    input.location        = inloc;
+    input.dimensions      = hidl_vec<uint32_t>{};
+
+    DataLocation outloc    = {};
+    outloc.poolIndex       = 1;
+    outloc.offset          = 0;
+    outloc.length          = 4 * sizeof(float);
+    RequestArgument output = {};
+    output.location        = outloc;
+    output.dimensions      = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    float indata[] = {1, 0, -1, 2};
+    AddPoolAndSetData(4, request, indata);
+
+    android::sp<IMemory> outMemory = AddPoolAndGetData(4, request);
+    float*               outdata   = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+
+    Execute(preparedModel, request);
+
+    // 2x - 1 = {1, -1, -3, 3}, relu = {1, 0, 0, 3}, 2x - 1 = {1, -1, -1, 5}
+    BOOST_TEST(outdata[0] == 1);
+    BOOST_TEST(outdata[1] == -1);
+    BOOST_TEST(outdata[2] == -1);
+    BOOST_TEST(outdata[3] == 5);
+}
+
+BOOST_AUTO_TEST_CASE(ConvFollowedByChannelScaleAndOffset)
+{
+    // the MUL and ADD by per-channel constants are folded into the convolution's weights and bias
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    V1_0::Model model = {};
+
+    float weightValue[] = {1, -1};
+    float biasValue[]   = {0, 0};
+    float scaleValue[]  = {3, 4};
+    float offsetValue[] = {1, 1};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 1, 2, 1});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1, 1, 1}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, biasValue);
+    AddIntOperand(model, (int32_t)android::nn::kPaddingValid); // padding
+    AddIntOperand(model, 1); // stride x
+    AddIntOperand(model, 1); // stride y
+    AddIntOperand(model, 0); // no activation
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 1, 2, 2});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, scaleValue);
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 1, 2, 2});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 1, 1, 2}, offsetValue);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1, 2, 2});
+
+    model.operations.resize(3);
+    model.operations[0].type = V1_0::OperationType::CONV_2D;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3, 4, 5, 6};
+    model.operations[0].outputs = hidl_vec<uint32_t>{7};
+    model.operations[1].type = V1_0::OperationType::MUL;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{7, 8, 6};
+    model.operations[1].outputs = hidl_vec<uint32_t>{9};
+    model.operations[2].type = V1_0::OperationType::ADD;
+    model.operations[2].inputs  = hidl_vec<uint32_t>{10, 9, 6};
+    model.operations[2].outputs = hidl_vec<uint32_t>{11};
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    // construct the request
+    DataLocation inloc    = {};
+    inloc.poolIndex       = 0;
+    inloc.offset          = 0;
+    inloc.length          = 2 * sizeof(float);
+    RequestArgument input = {};
+    input.location        = inloc;
+    input.dimensions      = hidl_vec<uint32_t>{};
+
+    DataLocation outloc    = {};
+    outloc.poolIndex       = 1;
+    outloc.offset          = 0;
+    outloc.length          = 4 * sizeof(float);
+    RequestArgument output = {};
+    output.location        = outloc;
+    output.dimensions      = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    float indata[] = {1, 2};
+    AddPoolAndSetData(2, request, indata);
+
+    android::sp<IMemory> outMemory = AddPoolAndGetData(4, request);
+    float*               outdata   = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+
+    Execute(preparedModel, request);
+
+    // conv = {1, -1, 2, -2}, * {3, 4} = {3, -4, 6, -8}, + 1 = {4, -3, 7, -7}
+    BOOST_TEST(outdata[0] == 4);
+    BOOST_TEST(outdata[1] == -3);
+    BOOST_TEST(outdata[2] == 7);
+    BOOST_TEST(outdata[3] == -7);
+}
+
+BOOST_AUTO_TEST_CASE(ConvFollowedByNonChannelScaleIsNotFolded)
+{
+    // a [ 2, 1 ] constant has as many values as the convolution has channels, but is broadcast along the width
+    // rather than the channels, so the MUL can't be folded into the convolution
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    V1_0::Model model = {};
+
+    float weightValue[] = {1, -1};
+    float biasValue[]   = {0, 0};
+    float scaleValue[]  = {3, 4};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 1, 2, 1});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1, 1, 1}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, biasValue);
+    AddIntOperand(model, (int32_t)android::nn::kPaddingValid); // padding
+    AddIntOperand(model, 1); // stride x
+    AddIntOperand(model, 1); // stride y
+    AddIntOperand(model, 0); // no activation
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 1, 2, 2});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1}, scaleValue);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1, 2, 2});
+
+    model.operations.resize(2);
+    model.operations[0].type = V1_0::OperationType::CONV_2D;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3, 4, 5, 6};
+    model.operations[0].outputs = hidl_vec<uint32_t>{7};
+    model.operations[1].type = V1_0::OperationType::MUL;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{7, 8, 6};
+    model.operations[1].outputs = hidl_vec<uint32_t>{9};
+
+    std::set<unsigned int> unsupportedOperations;
+    armnn_driver::ModelToINetworkConverter converter(armnn::Compute::CpuRef, model, unsupportedOperations);
+    BOOST_TEST((converter.GetConversionResult() == armnn_driver::ConversionResult::Success));
+    BOOST_TEST(converter.GetOperationCosts()[1].m_Flops > 0.0);
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    // construct the request
+    DataLocation inloc    = {};
+    inloc.poolIndex       = 0;
+    inloc.offset          = 0;
+    inloc.length          = 2 * sizeof(float);
+    RequestArgument input = {};
+    input.location        = inloc;
+    input.dimensions      = hidl_vec<uint32_t>{};
+
+    DataLocation outloc    = {};
+    outloc.poolIndex       = 1;
+    outloc.offset          = 0;
+    outloc.length          = 4 * sizeof(float);
+    RequestArgument output = {};
+    output.location        = outloc;
+    output.dimensions      = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    float indata[] = {1, 2};
+    AddPoolAndSetData(2, request, indata);
+
+    android::sp<IMemory> outMemory = AddPoolAndGetData(4, request);
+    float*               outdata   = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+
+    Execute(preparedModel, request);
+
+    // conv = {1, -1, 2, -2}, with both channels of the first position * 3 and of the second * 4 = {3, -3, 8, -8}
+    // (folding it per channel would give {3, -4, 6, -8})
+    BOOST_TEST(outdata[0] == 3);
+    BOOST_TEST(outdata[1] == -3);
+    BOOST_TEST(outdata[2] == 8);
+    BOOST_TEST(outdata[3] == -8);
+}
+
+BOOST_AUTO_TEST_CASE(ResidualAdditionAfterConv)
+{
+    // conv(x) + x -> relu: the shortcut reads the convolution's input, as in a residual block
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    V1_0::Model model = {};
+
+    float weightValue[] = {1, 2, 3};
+    float biasValue[]   = {0};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 1, 3, 1});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 1, 3, 1}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, biasValue);
+    AddIntOperand(model, 1); // pad left
+    AddIntOperand(model, 1); // pad right
+    AddIntOperand(model, 0); // pad top
+    AddIntOperand(model, 0); // pad bottom
+    AddIntOperand(model, 1); // stride x
+    AddIntOperand(model, 1); // stride y
+    AddIntOperand(model, 0); // no activation
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 1, 3, 1});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 1, 3, 1});
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1, 3, 1});
+
+    model.operations.resize(3);
+    model.operations[0].type = V1_0::OperationType::CONV_2D;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    model.operations[0].outputs = hidl_vec<uint32_t>{10};
+    model.operations[1].type = V1_0::OperationType::ADD;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{10, 0, 9};
+    model.operations[1].outputs = hidl_vec<uint32_t>{11};
+    model.operations[2].type = V1_0::OperationType::RELU;
+    model.operations[2].inputs  = hidl_vec<uint32_t>{11};
+    model.operations[2].outputs = hidl_vec<uint32_t>{12};
+
+    std::set<unsigned int> unsupportedOperations;
+    armnn_driver::ModelToINetworkConverter converter(armnn::Compute::CpuRef, model, unsupportedOperations);
+    BOOST_TEST((converter.GetConversionResult() == armnn_driver::ConversionResult::Success));
+    BOOST_TEST(converter.GetOperationCosts()[1].m_Flops > 0.0);
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    // construct the request
+    DataLocation inloc    = {};
+    inloc.poolIndex       = 0;
+    inloc.offset          = 0;
+    inloc.length          = 3 * sizeof(float);
+    RequestArgument input = {};
+    input.location        = inloc;
+    input.dimensions      = hidl_vec<uint32_t>{};
+
+    DataLocation outloc    = {};
+    outloc.poolIndex       = 1;
+    outloc.offset          = 0;
+    outloc.length          = 3 * sizeof(float);
+    RequestArgument output = {};
+    output.location        = outloc;
+    output.dimensions      = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    float indata[] = {1, -2, 3};
+    AddPoolAndSetData(3, request, indata);
+
+    android::sp<IMemory> outMemory = AddPoolAndGetData(3, request);
+    float*               outdata   = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+
+    Execute(preparedModel, request);
+
+    // conv = {-4, 6, 4}, + x = {-3, 4, 7}, relu = {0, 4, 7}
+    BOOST_TEST(outdata[0] == 0);
+    BOOST_TEST(outdata[1] == 4);
+    BOOST_TEST(outdata[2] == 7);
+}
+
+BOOST_AUTO_TEST_CASE(DepthwiseConvWithDepthMultiplier)
+{
+    // each of the 2 input channels produces 2 output channels, channel i * 2 + m using the weights for (i, m)
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    V1_0::Model model = {};
+
+    float weightValue[] = {1, 2, 3, 4};
+    float biasValue[]   = {0, 0, 0, 1};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 1, 2, 2});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 1, 1, 4}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{4}, biasValue);
+    AddIntOperand(model, (int32_t)android::nn::kPaddingValid); // padding
+    AddIntOperand(model, 1); // stride x
+    AddIntOperand(model, 1); // stride y
+    AddIntOperand(model, 2); // depth multiplier
+    AddIntOperand(model, 0); // no activation
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1, 2, 4});
+
+    model.operations.resize(1);
+    model.operations[0].type = V1_0::OperationType::DEPTHWISE_CONV_2D;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3, 4, 5, 6, 7};
+    model.operations[0].outputs = hidl_vec<uint32_t>{8};
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    // construct the request
+    DataLocation inloc    = {};
+    inloc.poolIndex       = 0;
+    inloc.offset          = 0;
+    inloc.length          = 4 * sizeof(float);
+    RequestArgument input = {};
+    input.location        = inloc;
+    input.dimensions      = hidl_vec<uint32_t>{};
+
+    DataLocation outloc    = {};
+    outloc.poolIndex       = 1;
+    outloc.offset          = 0;
+    outloc.length          = 8 * sizeof(float);
+    RequestArgument output = {};
+    output.location        = outloc;
+    output.dimensions      = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    float indata[] = {1, 2, 3, 4};
+    AddPoolAndSetData(4, request, indata);
+
+    android::sp<IMemory> outMemory = AddPoolAndGetData(8, request);
+    float*               outdata   = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+
+    Execute(preparedModel, request);
+
+    // {1 * 1, 1 * 2, 2 * 3, 2 * 4 + 1} and {3 * 1, 3 * 2, 4 * 3, 4 * 4 + 1}
+    const float expected[] = {1, 2, 6, 9, 3, 6, 12, 17};
+    for (unsigned int i = 0; i < 8; ++i)
+    {
+        BOOST_TEST(outdata[i] == expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(QuantizedDepthwiseConv5x5)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    V1_0::Model model = {};
+
+    // weights of 1 for channel 0 and 2 for channel 1, and inputs of 1 and 2 likewise
+    uint8_t weightValue[50];
+    uint8_t indata[50];
+    for (unsigned int i = 0; i < 50; ++i)
+    {
+        weightValue[i] = static_cast<uint8_t>(1 + i % 2);
+        indata[i]      = static_cast<uint8_t>(1 + i % 2);
+    }
+    int32_t biasValue[] = {1, 0};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 5, 5, 2}, OperandType::TENSOR_QUANT8_ASYMM, 1.0f, 0);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 5, 5, 2}, weightValue, 1.0f, 0);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, biasValue, 1.0f, 0);
+    AddIntOperand(model, (int32_t)android::nn::kPaddingValid); // padding
+    AddIntOperand(model, 1); // stride x
+    AddIntOperand(model, 1); // stride y
+    AddIntOperand(model, 1); // depth multiplier
+    AddIntOperand(model, 0); // no activation
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1, 1, 2}, OperandType::TENSOR_QUANT8_ASYMM, 2.0f, 0);
+
+    model.operations.resize(1);
+    model.operations[0].type = V1_0::OperationType::DEPTHWISE_CONV_2D;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3, 4, 5, 6, 7};
+    model.operations[0].outputs = hidl_vec<uint32_t>{8};
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    // construct the request
+    DataLocation inloc    = {};
+    inloc.poolIndex       = 0;
+    inloc.offset          = 0;
+    inloc.length          = 50 * sizeof(uint8_t);
+    RequestArgument input = {};
+    input.location        = inloc;
+    input.dimensions      = hidl_vec<uint32_t>{};
+
+    DataLocation outloc    = {};
+    outloc.poolIndex       = 1;
+    outloc.offset          = 0;
+    outloc.length          = 2 * sizeof(uint8_t);
+    RequestArgument output = {};
+    output.location        = outloc;
+    output.dimensions      = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    AddPoolAndSetData(50, request, indata);
+
+    android::sp<IMemory> outMemory = AddPoolAndGetData(1, request);
+    uint8_t*             outdata   = static_cast<uint8_t*>(static_cast<void*>(outMemory->getPointer()));
+
+    Execute(preparedModel, request);
+
+    // (25 * 1 * 1 + 1) / 2 and (25 * 2 * 2) / 2
+    BOOST_TEST(outdata[0] == 13);
+    BOOST_TEST(outdata[1] == 50);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+#include "DriverTestHelpers.hpp"
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include "../CostModel.hpp"
+
+BOOST_AUTO_TEST_SUITE(CostModelTests)
+
+using namespace armnn_driver;
+using namespace driverTestHelpers;
+
+namespace
+{
+
+// Builds input -> RELU -> [middle operation] -> RELU -> output, where the middle operation
+// is either another RELU (cheap) or a large fully connected layer (expensive)
+V1_0::Model CreateSandwichModel(bool expensiveMiddleOperation)
+{
+    const uint32_t size = 1024;
+
+    V1_0::Model model = {};
+    AddInputOperand(model, hidl_vec<uint32_t>{1, size});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, size});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, size});
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, size});
+
+    model.operations.resize(3);
+    model.operations[0].type    = V1_0::OperationType::RELU;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0};
+    model.operations[0].outputs = hidl_vec<uint32_t>{1};
+
+    if (expensiveMiddleOperation)
+    {
+        std::vector<float> weights(size * size, 1.0f);
+        std::vector<float> bias(size, 0.0f);
+        AddTensorOperand(model, hidl_vec<uint32_t>{size, size}, weights.data());
+        AddTensorOperand(model, hidl_vec<uint32_t>{size}, bias.data());
+        AddIntOperand(model, 0);
+
+        model.operations[1].type   = V1_0::OperationType::FULLY_CONNECTED;
+        model.operations[1].inputs = hidl_vec<uint32_t>{1, 4, 5, 6};
+    }
+    else
+    {
+        model.operations[1].type   = V1_0::OperationType::RELU;
+        model.operations[1].inputs = hidl_vec<uint32_t>{1};
+    }
+    model.operations[1].outputs = hidl_vec<uint32_t>{2};
+
+    model.operations[2].type    = V1_0::OperationType::RELU;
+    model.operations[2].inputs  = hidl_vec<uint32_t>{2};
+    model.operations[2].outputs = hidl_vec<uint32_t>{3};
+
+    return model;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(CheapIsolatedOperationIsDeclined)
+{
+    V1_0::Model model = CreateSandwichModel(false);
+
+    std::vector<bool> supported = { false, true, false };
+    ApplyPartitionCostModel(model, supported, true);
+
+    BOOST_TEST(supported[0] == false);
+    BOOST_TEST(supported[1] == false);
+    BOOST_TEST(supported[2] == false);
+}
+
+BOOST_AUTO_TEST_CASE(ExpensiveIsolatedOperationIsKept)
+{
+    V1_0::Model model = CreateSandwichModel(true);
+
+    std::vector<bool> supported = { false, true, false };
+    ApplyPartitionCostModel(model, supported, true);
+
+    BOOST_TEST(supported[0] == false);
+    BOOST_TEST(supported[1] == true);
+    BOOST_TEST(supported[2] == false);
+}
+
+BOOST_AUTO_TEST_CASE(FullySupportedModelIsKept)
+{
+    V1_0::Model model = CreateSandwichModel(false);
+
+    std::vector<bool> supported = { true, true, true };
+    ApplyPartitionCostModel(model, supported, true);
+
+    BOOST_TEST(supported[0] == true);
+    BOOST_TEST(supported[1] == true);
+    BOOST_TEST(supported[2] == true);
+}
+
+BOOST_AUTO_TEST_CASE(FullyConnectedCostComesFromWeights)
+{
+    V1_0::Model model = CreateSandwichModel(true);
+
+    const OperationCost cost = EstimateOperationCost(model, model.operations[1]);
+
+    // 2 flops per multiply-accumulate, one per weight for a batch of one
+    BOOST_TEST(cost.m_Flops == 2.0 * 1024 * 1024);
+    // input, weights, bias and output
+    BOOST_TEST(cost.m_Bytes == 4.0 * (1024 + 1024 * 1024 + 1024 + 1024));
+    BOOST_TEST(cost.m_WeightBytes == 4.0 * (1024 * 1024 + 1024));
+    BOOST_TEST(cost.m_InputBytes == 4.0 * 1024);
+    BOOST_TEST(cost.m_OutputBytes == 4.0 * 1024);
+}
+
+BOOST_AUTO_TEST_CASE(CostReportListsHeaviestOperationFirst)
+{
+    V1_0::Model model = CreateSandwichModel(true);
+
+    std::vector<OperationCost> costs;
+    for (const V1_0::Operation& operation : model.operations)
+    {
+        costs.push_back(EstimateOperationCost(model, operation));
+    }
+
+    const std::string report = GetCostReport(model, costs, 0.0, 1);
+
+    BOOST_TEST(report.find("Total for 3 operation(s)") != std::string::npos);
+    BOOST_TEST(report.find("Heaviest 1 operation(s)") != std::string::npos);
+    BOOST_TEST(report.find("1 FULLY_CONNECTED") != std::string::npos);
+    BOOST_TEST(report.find("RELU:") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -31,9 +31,9 @@ namespace driverTestHelpers
 
 Return<void> ExecutionCallback::notify(ErrorStatus status)
 {
-    (void)status;
     ALOGI("ExecutionCallback::notify invoked");
     std::lock_guard<std::mutex> executionLock(mMutex);
+    mErrorStatus = status;
     mNotified = true;
     mCondition.notify_one();
     return Void();
@@ -107,6 +107,15 @@ void AddPoolAndSetData(uint32_t size, Request& request, const float* data)
     memcpy(dst, data, size * sizeof(float));
 }
 
+void AddPoolAndSetData(uint32_t size, Request& request, const uint8_t* data)
+{
+    android::sp<IMemory> memory = AddPoolAndGetData(size, request);
+
+    uint8_t* dst = static_cast<uint8_t*>(static_cast<void*>(memory->getPointer()));
+
+    memcpy(dst, data, size * sizeof(uint8_t));
+}
+
 void AddOperand(V1_0::Model& model, const Operand& op)
 {
     model.operands.resize(model.operands.size() + 1);
@@ -131,11 +140,42 @@ void AddIntOperand(V1_0::Model& model, int32_t value)
     AddOperand(model, op);
 }
 
-void AddInputOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions)
+void AddFloatOperand(V1_0::Model& model, float value)
 {
+    DataLocation location = {};
+    location.offset = model.operandValues.size();
+    location.length = sizeof(float);
+
     Operand op    = {};
+    op.type = OperandType::FLOAT32;
+    op.dimensions = hidl_vec<uint32_t>{};
+    op.lifetime   = OperandLifeTime::CONSTANT_COPY;
+    op.location   = location;
+
+    model.operandValues.resize(model.operandValues.size() + location.length);
+    *reinterpret_cast<float*>(&model.operandValues[location.offset]) = value;
+
+    AddOperand(model, op);
+}
+
+void AddNoValueOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions)
+{
+    Operand op = {};
     op.type       = OperandType::TENSOR_FLOAT32;
     op.dimensions = dimensions;
+    op.lifetime   = OperandLifeTime::NO_VALUE;
+
+    AddOperand(model, op);
+}
+
+void AddInputOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions,
+                     OperandType type, float scale, int32_t zeroPoint)
+{
+    Operand op    = {};
+    op.type       = type;
+    op.scale      = scale;
+    op.zeroPoint  = zeroPoint;
+    op.dimensions = dimensions;
     op.lifetime   = OperandLifeTime::MODEL_INPUT;
 
     AddOperand(model, op);
@@ -144,10 +184,13 @@ void AddInputOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions)
     model.inputIndexes[model.inputIndexes.size() - 1] = model.operands.size() - 1;
 }
 
-void AddOutputOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions)
+void AddOutputOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions,
+                      OperandType type, float scale, int32_t zeroPoint)
 {
     Operand op = {};
-    op.type       = OperandType::TENSOR_FLOAT32;
+    op.type       = type;
+    op.scale      = scale;
+    op.zeroPoint  = zeroPoint;
     op.dimensions = dimensions;
     op.lifetime   = OperandLifeTime::MODEL_OUTPUT;
 
@@ -157,6 +200,16 @@ void AddOutputOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions)
     model.outputIndexes[model.outputIndexes.size() - 1] = model.operands.size() - 1;
 }
 
+void AddTemporaryOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions)
+{
+    Operand op = {};
+    op.type       = OperandType::TENSOR_FLOAT32;
+    op.dimensions = dimensions;
+    op.lifetime   = OperandLifeTime::TEMPORARY_VARIABLE;
+
+    AddOperand(model, op);
+}
+
 
 android::sp<IPreparedModel> PrepareModelWithStatus(const V1_0::Model& model,
                                                    armnn_driver::ArmnnDriver& driver,
@@ -215,4 +268,10 @@ OperandType TypeToOperandType<int32_t>()
     return OperandType::TENSOR_INT32;
 };
 
+template<>
+OperandType TypeToOperandType<uint8_t>()
+{
+    return OperandType::TENSOR_QUANT8_ASYMM;
+};
+
 } // namespace driverTestHelpers
@@ -34,10 +34,12 @@ std::ostream& operator<<(std::ostream& os, android::hardware::neuralnetworks::V1
 
 struct ExecutionCallback : public IExecutionCallback
 {
-    ExecutionCallback() : mNotified(false) {}
+    ExecutionCallback() : mNotified(false), mErrorStatus(ErrorStatus::NONE) {}
     Return<void> notify(ErrorStatus status) override;
     /// wait until the callback has notified us that it is done
     Return<void> wait();
+    /// the status the execution finished with (once waited for)
+    ErrorStatus GetErrorStatus() { return mErrorStatus; }
 
 private:
     // use a mutex and a condition variable to wait for asynchronous callbacks
@@ -45,6 +47,7 @@ private:
     std::condition_variable mCondition;
     // and a flag, in case we are notified before the wait call
     bool mNotified;
+    ErrorStatus mErrorStatus;
 };
 
 class PreparedModelCallback : public IPreparedModelCallback
@@ -72,10 +75,17 @@ android::sp<IMemory> AddPoolAndGetData(uint32_t size, Request& request);
 
 void AddPoolAndSetData(uint32_t size, Request& request, const float* data);
 
+void AddPoolAndSetData(uint32_t size, Request& request, const uint8_t* data);
+
 void AddOperand(V1_0::Model& model, const Operand& op);
 
 void AddIntOperand(V1_0::Model& model, int32_t value);
 
+void AddFloatOperand(V1_0::Model& model, float value);
+
+// Adds an omitted optional operand
+void AddNoValueOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions);
+
 template<typename T>
 OperandType TypeToOperandType();
 
@@ -85,8 +95,12 @@ OperandType TypeToOperandType<float>();
 template<>
 OperandType TypeToOperandType<int32_t>();
 
+template<>
+OperandType TypeToOperandType<uint8_t>();
+
 template<typename T>
-void AddTensorOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions, T* values)
+void AddTensorOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions, T* values,
+                      float scale = 0.0f, int32_t zeroPoint = 0)
 {
     uint32_t totalElements = 1;
     for (uint32_t dim : dimensions)
@@ -103,6 +117,8 @@ void AddTensorOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions, T* valu
     op.dimensions = dimensions;
     op.lifetime   = OperandLifeTime::CONSTANT_COPY;
     op.location   = location;
+    op.scale      = scale;
+    op.zeroPoint  = zeroPoint;
 
     model.operandValues.resize(model.operandValues.size() + location.length);
     for (uint32_t i = 0; i < totalElements; i++)
@@ -113,9 +129,13 @@ void AddTensorOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions, T* valu
     AddOperand(model, op);
 }
 
-void AddInputOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions);
+void AddInputOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions,
+                     OperandType type = OperandType::TENSOR_FLOAT32, float scale = 0.0f, int32_t zeroPoint = 0);
+
+void AddOutputOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions,
+                      OperandType type = OperandType::TENSOR_FLOAT32, float scale = 0.0f, int32_t zeroPoint = 0);
 
-void AddOutputOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions);
+void AddTemporaryOperand(V1_0::Model& model, hidl_vec<uint32_t> dimensions);
 
 android::sp<IPreparedModel> PrepareModel(const V1_0::Model& model,
                                          armnn_driver::ArmnnDriver& driver);
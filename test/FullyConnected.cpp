@@ -251,4 +251,246 @@ BOOST_AUTO_TEST_CASE(TestFullyConnected4dInputReshape)
     BOOST_TEST(outdata[7] == 8);
 }
 
+BOOST_AUTO_TEST_CASE(FullyConnectedFollowedByRelu6)
+{
+    // the standalone RELU6 is fused into the fully connected layer
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    V1_0::Model model = {};
+
+    // add operands
+    int32_t actValue      = 0;
+    float   weightValue[] = {1, 1, 1,
+                             -1, -1, -1};
+    float   biasValue[]   = {0, 0};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 3});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 3}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, biasValue);
+    AddIntOperand(model, actValue);
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2});
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2});
+
+    model.operations.resize(2);
+    model.operations[0].type = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+    model.operations[1].type = V1_0::OperationType::RELU6;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{4};
+    model.operations[1].outputs = hidl_vec<uint32_t>{5};
+
+    // make the prepared model
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    // construct the request
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = 3 * sizeof(float);
+    RequestArgument input = {};
+    input.location = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = 2 * sizeof(float);
+    RequestArgument output = {};
+    output.location  = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    // set the input data
+    float indata[] = {2, 3, 4};
+    AddPoolAndSetData(3, request, indata);
+
+    // add memory for the output
+    android::sp<IMemory> outMemory = AddPoolAndGetData(2, request);
+    float* outdata = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+
+    // run the execution
+    Execute(preparedModel, request);
+
+    // check the result: {9, -9} clamped to [0, 6]
+    BOOST_TEST(outdata[0] == 6);
+    BOOST_TEST(outdata[1] == 0);
+}
+
+BOOST_AUTO_TEST_CASE(QuantizedFullyConnected)
+{
+    // the quantized equivalent of the FullyConnected test, with the result halved by the output scale
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    V1_0::Model model = {};
+
+    // add operands
+    int32_t actValue      = 0;
+    uint8_t weightValue[] = {2, 4, 1};
+    int32_t biasValue[]   = {4};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 3}, OperandType::TENSOR_QUANT8_ASYMM, 1.0f, 0);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 3}, weightValue, 1.0f, 0);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, biasValue, 1.0f, 0);
+    AddIntOperand(model, actValue);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1}, OperandType::TENSOR_QUANT8_ASYMM, 2.0f, 0);
+
+    // make the fully connected operation
+    model.operations.resize(1);
+    model.operations[0].type = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    // make the prepared model
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    // construct the request
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = 3 * sizeof(uint8_t);
+    RequestArgument input = {};
+    input.location = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = 1 * sizeof(uint8_t);
+    RequestArgument output = {};
+    output.location  = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    // set the input data
+    uint8_t indata[] = {2, 32, 16};
+    AddPoolAndSetData(3, request, indata);
+
+    // add memory for the output
+    android::sp<IMemory> outMemory = AddPoolAndGetData(1, request);
+    uint8_t* outdata = static_cast<uint8_t*>(static_cast<void*>(outMemory->getPointer()));
+
+    // run the execution
+    Execute(preparedModel, request);
+
+    // check the result: 152 / 2
+    BOOST_TEST(outdata[0] == 76);
+}
+
+BOOST_AUTO_TEST_CASE(QuantizedFullyConnected4dInputReshape)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    V1_0::Model model = {};
+
+    // operands
+    int32_t actValue      = 0;
+    uint8_t weightValue[] = {1, 0, 0, 0, 0, 0, 0, 0,
+                             0, 1, 0, 0, 0, 0, 0, 0,
+                             0, 0, 1, 0, 0, 0, 0, 0,
+                             0, 0, 0, 1, 0, 0, 0, 0,
+                             0, 0, 0, 0, 1, 0, 0, 0,
+                             0, 0, 0, 0, 0, 1, 0, 0,
+                             0, 0, 0, 0, 0, 0, 1, 0,
+                             0, 0, 0, 0, 0, 0, 0, 1}; //identity
+    int32_t biasValue[]   = {0, 0, 0, 0, 0, 0, 0, 0};
+
+    // fully connected operation, with the input and output in different quantization spaces
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2}, OperandType::TENSOR_QUANT8_ASYMM, 0.5f, 10);
+    AddTensorOperand(model, hidl_vec<uint32_t>{8, 8}, weightValue, 1.0f, 0);
+    AddTensorOperand(model, hidl_vec<uint32_t>{8}, biasValue, 0.5f, 0);
+    AddIntOperand(model, actValue);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 8}, OperandType::TENSOR_QUANT8_ASYMM, 1.0f, 10);
+
+    model.operations.resize(1);
+
+    model.operations[0].type = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0,1,2,3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    // make the prepared model
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    // construct the request
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = 8 * sizeof(uint8_t);
+    RequestArgument input = {};
+    input.location = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = 8 * sizeof(uint8_t);
+    RequestArgument output = {};
+    output.location  = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    // set the input data: the values 1 to 8
+    uint8_t indata[] = {12, 14, 16, 18, 20, 22, 24, 26};
+    AddPoolAndSetData(8, request, indata);
+
+    // add memory for the output
+    android::sp<IMemory> outMemory = AddPoolAndGetData(8, request);
+    uint8_t* outdata = static_cast<uint8_t*>(static_cast<void*>(outMemory->getPointer()));
+
+    // run the execution
+    Execute(preparedModel, request);
+
+    // check the result: the values 1 to 8 again
+    for (unsigned int i = 0; i < 8; ++i)
+    {
+        BOOST_TEST(outdata[i] == 11 + i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(QuantizedFullyConnectedOutputScaleTooSmall)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    ErrorStatus error;
+    std::vector<bool> sup;
+
+    ArmnnDriver::getSupportedOperations_cb cb = [&](ErrorStatus status, const std::vector<bool>& supported)
+        {
+            error = status;
+            sup = supported;
+        };
+
+    V1_0::Model model = {};
+
+    int32_t actValue      = 0;
+    uint8_t weightValue[] = {2, 4, 1};
+    int32_t biasValue[]   = {4};
+
+    // the output scale must be greater than the product of the input and weights scales (0.5 * 2)
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 3}, OperandType::TENSOR_QUANT8_ASYMM, 0.5f, 0);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 3}, weightValue, 2.0f, 0);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, biasValue, 1.0f, 0);
+    AddIntOperand(model, actValue);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1}, OperandType::TENSOR_QUANT8_ASYMM, 1.0f, 0);
+
+    model.operations.resize(1);
+    model.operations[0].type = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    driver->getSupportedOperations(model, cb);
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(sup[0] == false);
+
+    model.operands[4].scale = 1.5f;
+    driver->getSupportedOperations(model, cb);
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(sup[0] == true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
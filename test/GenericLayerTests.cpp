@@ -6,6 +6,9 @@
 #include <boost/test/unit_test.hpp>
 #include <log/log.h>
 
+#include "../LayerSupportCache.hpp"
+#include "../ModelToINetworkConverter.hpp"
+
 BOOST_AUTO_TEST_SUITE(GenericLayerTests)
 
 using ArmnnDriver = armnn_driver::ArmnnDriver;
@@ -169,6 +172,38 @@ BOOST_AUTO_TEST_CASE(UnsupportedLayerContinueOnFailure)
     BOOST_TEST(sup[2] == false);
 }
 
+// An operation the preferred device can't run is still supported if the fallback can run it, and is placed there
+BOOST_AUTO_TEST_CASE(OperationOnlyFallbackSupportsIsSupported)
+{
+    V1_0::Model model = {};
+
+    float weightValue[] = {2, 4, 1};
+    float biasValue[]   = {4};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 3});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 3}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, biasValue);
+    AddIntOperand(model, 0);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1});
+
+    model.operations.resize(1);
+    model.operations[0].type = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    // No layer is supported on Compute::Undefined, which stands in for a device lacking the operation
+    std::set<unsigned int> unsupportedOperations;
+    armnn_driver::ModelToINetworkConverter converter(
+        std::vector<armnn::Compute>{armnn::Compute::Undefined}, model, unsupportedOperations);
+    BOOST_TEST(!converter.IsOperationSupported(0));
+
+    armnn_driver::ModelToINetworkConverter fallbackConverter(
+        std::vector<armnn::Compute>{armnn::Compute::Undefined, armnn::Compute::CpuRef}, model, unsupportedOperations);
+    BOOST_TEST((int)fallbackConverter.GetConversionResult() == (int)armnn_driver::ConversionResult::Success);
+    BOOST_TEST(fallbackConverter.IsOperationSupported(0));
+    BOOST_TEST((fallbackConverter.GetOperationBackend(0) == armnn::Compute::CpuRef));
+}
+
 // The purpose of this test is to ensure that when encountering an failure
 //      during mem pool mapping we properly report an error to the framework via a callback
 BOOST_AUTO_TEST_CASE(ModelToINetworkConverterMemPoolFail)
@@ -193,4 +228,727 @@ BOOST_AUTO_TEST_CASE(ModelToINetworkConverterMemPoolFail)
     BOOST_TEST((int)error == (int)ErrorStatus::GENERAL_FAILURE);
 }
 
+// Operations which don't contribute to any model output are skipped (and so reported as supported)
+BOOST_AUTO_TEST_CASE(DeadOperationsAreSkipped)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    ErrorStatus error;
+    std::vector<bool> sup;
+
+    ArmnnDriver::getSupportedOperations_cb cb = [&](ErrorStatus status, const std::vector<bool>& supported)
+    {
+        error = status;
+        sup = supported;
+    };
+
+    V1_0::Model model = {};
+
+    int32_t actValue      = 0;
+    float   weightValue[] = {2, 4, 1};
+    float   biasValue[]   = {4};
+
+    // fully connected
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 3});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 3}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, biasValue);
+    AddIntOperand(model, actValue);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1});
+
+    // a branch whose result is never used, containing an unsupported (broadcast) add
+    AddInputOperand(model, hidl_vec<uint32_t>{4});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 3});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 3});
+
+    model.operations.resize(3);
+
+    model.operations[0].type = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    model.operations[1].type = V1_0::OperationType::ADD;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{0, 5};
+    model.operations[1].outputs = hidl_vec<uint32_t>{6};
+
+    model.operations[2].type = V1_0::OperationType::RELU;
+    model.operations[2].inputs  = hidl_vec<uint32_t>{6};
+    model.operations[2].outputs = hidl_vec<uint32_t>{7};
+
+    driver->getSupportedOperations(model, cb);
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(sup[0] == true);
+    BOOST_TEST(sup[1] == true);
+    BOOST_TEST(sup[2] == true);
+}
+
+// Operations whose inputs are all constant are evaluated during the conversion
+BOOST_AUTO_TEST_CASE(ConstantOperationsAreFolded)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    ErrorStatus error;
+    std::vector<bool> sup;
+
+    ArmnnDriver::getSupportedOperations_cb cb = [&](ErrorStatus status, const std::vector<bool>& supported)
+    {
+        error = status;
+        sup = supported;
+    };
+
+    V1_0::Model model = {};
+
+    float constant0[] = {1, 2};
+    float constant1[] = {3, -4};
+
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 2}, constant0);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 2}, constant1);
+    AddIntOperand(model, 1); // relu
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2});
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2});
+    AddIntOperand(model, 0); // no activation
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2});
+
+    model.operations.resize(2);
+
+    // constant only: relu(constant0 + constant1) = {4, 0}
+    model.operations[0].type = V1_0::OperationType::ADD;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2};
+    model.operations[0].outputs = hidl_vec<uint32_t>{3};
+
+    model.operations[1].type = V1_0::OperationType::ADD;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{4, 3, 5};
+    model.operations[1].outputs = hidl_vec<uint32_t>{6};
+
+    driver->getSupportedOperations(model, cb);
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(sup[0] == true);
+    BOOST_TEST(sup[1] == true);
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    DataLocation inloc    = {};
+    inloc.poolIndex       = 0;
+    inloc.offset          = 0;
+    inloc.length          = 2 * sizeof(float);
+    RequestArgument input = {};
+    input.location        = inloc;
+    input.dimensions      = hidl_vec<uint32_t>{};
+
+    DataLocation outloc    = {};
+    outloc.poolIndex       = 1;
+    outloc.offset          = 0;
+    outloc.length          = 2 * sizeof(float);
+    RequestArgument output = {};
+    output.location        = outloc;
+    output.dimensions      = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    float indata[] = {10, 20};
+    AddPoolAndSetData(2, request, indata);
+
+    android::sp<IMemory> outMemory = AddPoolAndGetData(2, request);
+    float* outdata = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+
+    Execute(preparedModel, request);
+
+    BOOST_TEST(outdata[0] == 14);
+    BOOST_TEST(outdata[1] == 20);
+}
+
+// Checking the same model again answers every layer support query from the driver-wide cache
+BOOST_AUTO_TEST_CASE(LayerSupportQueriesAreCached)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    ErrorStatus error;
+    std::vector<bool> sup;
+
+    ArmnnDriver::getSupportedOperations_cb cb = [&](ErrorStatus status, const std::vector<bool>& supported)
+    {
+        error = status;
+        sup = supported;
+    };
+
+    V1_0::Model model = {};
+
+    int32_t actValue      = 0;
+    float   weightValue[] = {2, 4, 1};
+    float   biasValue[]   = {4};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 3});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 3}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, biasValue);
+    AddIntOperand(model, actValue);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1});
+
+    model.operations.resize(1);
+    model.operations[0].type = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    armnn_driver::LayerSupportCache& cache = armnn_driver::LayerSupportCache::GetInstance();
+
+    driver->getSupportedOperations(model, cb);
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(sup[0] == true);
+
+    const uint64_t numHits = cache.GetNumHits();
+    const uint64_t numMisses = cache.GetNumMisses();
+
+    driver->getSupportedOperations(model, cb);
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(sup[0] == true);
+
+    BOOST_TEST(cache.GetNumHits() > numHits);
+    BOOST_TEST(cache.GetNumMisses() == numMisses);
+}
+
+// Unsupported layers are cached too, so checking the model again doesn't ask ArmNN (or format its reasons) again
+BOOST_AUTO_TEST_CASE(UnsupportedLayerSupportQueriesAreCached)
+{
+    V1_0::Model model = {};
+
+    float weightValue[] = {2, 4, 1};
+    float biasValue[]   = {4};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 3});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 3}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, biasValue);
+    AddIntOperand(model, 0);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1});
+
+    model.operations.resize(1);
+    model.operations[0].type = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    // No layer is supported on Compute::Undefined
+    const std::vector<armnn::Compute> backends = {armnn::Compute::Undefined};
+    std::set<unsigned int> unsupportedOperations;
+    armnn_driver::LayerSupportCache& cache = armnn_driver::LayerSupportCache::GetInstance();
+
+    {
+        armnn_driver::ModelToINetworkConverter converter(backends, model, unsupportedOperations);
+        BOOST_TEST(!converter.IsOperationSupported(0));
+    }
+
+    const uint64_t numHits = cache.GetNumHits();
+    const uint64_t numMisses = cache.GetNumMisses();
+
+    {
+        armnn_driver::ModelToINetworkConverter converter(backends, model, unsupportedOperations);
+        BOOST_TEST(!converter.IsOperationSupported(0));
+    }
+
+    BOOST_TEST(cache.GetNumHits() > numHits);
+    BOOST_TEST(cache.GetNumMisses() == numMisses);
+}
+
+// Results are keyed on every byte of the query, so queries differing only slightly never share a result
+BOOST_AUTO_TEST_CASE(LayerSupportQueriesDifferingInOneArgumentAreDistinct)
+{
+    const armnn::TensorInfo info(armnn::TensorShape({1, 3}), armnn::DataType::Float32);
+    const armnn::TensorInfo otherInfo(armnn::TensorShape({1, 4}), armnn::DataType::Float32);
+    armnn::ActivationDescriptor desc;
+    desc.m_Function = armnn::ActivationFunction::BoundedReLu;
+    desc.m_A = 6.0f;
+
+    armnn_driver::LayerSupportQuery query;
+    query.AddAll(armnn::Compute::CpuRef, info, desc);
+    armnn_driver::LayerSupportQuery otherQuery;
+    otherQuery.AddAll(armnn::Compute::CpuRef, otherInfo, desc);
+    BOOST_TEST(query.GetKey() != otherQuery.GetKey());
+
+    armnn_driver::LayerSupportCache& cache = armnn_driver::LayerSupportCache::GetInstance();
+    cache.Insert(query.GetKey(), true);
+    cache.Insert(otherQuery.GetKey(), false);
+
+    bool isSupported = false;
+    BOOST_TEST(cache.Find(query.GetKey(), isSupported));
+    BOOST_TEST(isSupported);
+    BOOST_TEST(cache.Find(otherQuery.GetKey(), isSupported));
+    BOOST_TEST(!isSupported);
+}
+
+// Once the cache is full, each new result replaces the least recently used one, rather than emptying the cache
+BOOST_AUTO_TEST_CASE(FullLayerSupportCacheDropsLeastRecentlyUsedResult)
+{
+    armnn_driver::LayerSupportCache& cache = armnn_driver::LayerSupportCache::GetInstance();
+    cache.Clear();
+
+    cache.Insert("used", true);
+    cache.Insert("unused", true);
+
+    // More results than the cache holds (16384), while still using one of the first two
+    bool isSupported = false;
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        cache.Insert(std::to_string(i), false);
+        BOOST_REQUIRE(cache.Find("used", isSupported));
+    }
+
+    BOOST_TEST(isSupported);
+    BOOST_TEST(!cache.Find("unused", isSupported));
+    BOOST_TEST(cache.Find("19999", isSupported));
+    BOOST_TEST(!cache.Find("0", isSupported));
+
+    cache.Clear();
+}
+
+namespace
+{
+
+// A chain of numBlocks blocks of CONV_2D -> MUL -> ADD -> RELU, each MUL by a constant computed by an ADD of
+// two constants, so that every rewrite pass has work to do in each block. Returns the operation indices of the
+// convolutions.
+V1_0::Model CreateRewrittenChainModel(uint32_t numBlocks, std::vector<uint32_t>& convolutionIndices)
+{
+    V1_0::Model model = {};
+
+    float weightValue[] = {1, 0.5f, -0.5f, 1};
+    float biasValue[]   = {0, 1};
+    float scaleA[]      = {1, 2};
+    float scaleB[]      = {1, 1};
+    float offsetValue[] = {0.5f, -0.5f};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1, 1, 2}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, biasValue);
+    AddIntOperand(model, (int32_t)android::nn::kPaddingValid); // padding
+    AddIntOperand(model, 1); // stride
+    AddIntOperand(model, 0); // no activation
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, scaleA);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, scaleB);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, offsetValue);
+
+    auto addOperation = [&model](V1_0::OperationType type, hidl_vec<uint32_t> inputs, uint32_t output)
+    {
+        const size_t operationIdx = model.operations.size();
+        model.operations.resize(operationIdx + 1);
+        model.operations[operationIdx].type    = type;
+        model.operations[operationIdx].inputs  = inputs;
+        model.operations[operationIdx].outputs = hidl_vec<uint32_t>{output};
+    };
+
+    uint32_t blockInput = 0;
+    for (uint32_t i = 0; i < numBlocks; ++i)
+    {
+        const uint32_t scale = model.operands.size();
+        AddTemporaryOperand(model, hidl_vec<uint32_t>{2});
+        AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2}); // conv
+        AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2}); // mul
+        AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2}); // add
+        if (i + 1 < numBlocks)
+        {
+            AddTemporaryOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+        }
+        else
+        {
+            AddOutputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+        }
+
+        addOperation(V1_0::OperationType::ADD, hidl_vec<uint32_t>{6, 7, 5}, scale);
+        convolutionIndices.push_back(model.operations.size());
+        addOperation(V1_0::OperationType::CONV_2D, hidl_vec<uint32_t>{blockInput, 1, 2, 3, 4, 4, 5}, scale + 1);
+        addOperation(V1_0::OperationType::MUL, hidl_vec<uint32_t>{scale + 1, scale, 5}, scale + 2);
+        addOperation(V1_0::OperationType::ADD, hidl_vec<uint32_t>{scale + 2, 8, 5}, scale + 3);
+        addOperation(V1_0::OperationType::RELU, hidl_vec<uint32_t>{scale + 3}, scale + 4);
+        blockInput = scale + 4;
+    }
+
+    return model;
+}
+
+} // anonymous namespace
+
+// Each block's constant ADD is folded, its MUL and ADD are merged into the convolution, and its RELU is fused
+// into it. This holds for every block of a long chain, and the chain stays in the ArmNN layout throughout, so
+// four times as many blocks need no more layout conversions.
+BOOST_AUTO_TEST_CASE(RewritesApplyToEveryBlockOfLongChains)
+{
+    unsigned int numPermuteLayers[2] = {};
+    const uint32_t numBlocks[2] = {50, 200};
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+        std::vector<uint32_t> convolutionIndices;
+        const V1_0::Model model = CreateRewrittenChainModel(numBlocks[i], convolutionIndices);
+
+        std::set<unsigned int> unsupportedOperations;
+        armnn_driver::ModelToINetworkConverter converter(armnn::Compute::CpuRef, model, unsupportedOperations);
+        BOOST_TEST((int)converter.GetConversionResult() == (int)armnn_driver::ConversionResult::Success);
+        numPermuteLayers[i] = converter.GetNumPermuteLayers();
+
+        // Only the convolutions are left to run
+        const std::vector<armnn_driver::OperationCost>& costs = converter.GetOperationCosts();
+        BOOST_TEST(convolutionIndices.size() == numBlocks[i]);
+        for (uint32_t operationIdx = 0; operationIdx < model.operations.size(); ++operationIdx)
+        {
+            const bool isConvolution = std::find(convolutionIndices.begin(), convolutionIndices.end(),
+                                                 operationIdx) != convolutionIndices.end();
+            BOOST_TEST((costs[operationIdx].m_Flops > 0.0) == isConvolution);
+        }
+    }
+
+    BOOST_TEST(numPermuteLayers[0] == numPermuteLayers[1]);
+}
+
+namespace
+{
+
+// Runs a model with a single float input and output on the reference backend
+std::vector<float> ExecuteFloatModel(const V1_0::Model& model, std::vector<float> inputData, uint32_t numOutputs)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    DataLocation inloc    = {};
+    inloc.poolIndex       = 0;
+    inloc.offset          = 0;
+    inloc.length          = inputData.size() * sizeof(float);
+    RequestArgument input = {};
+    input.location        = inloc;
+    input.dimensions      = hidl_vec<uint32_t>{};
+
+    DataLocation outloc    = {};
+    outloc.poolIndex       = 1;
+    outloc.offset          = 0;
+    outloc.length          = numOutputs * sizeof(float);
+    RequestArgument output = {};
+    output.location        = outloc;
+    output.dimensions      = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    AddPoolAndSetData(inputData.size(), request, inputData.data());
+
+    android::sp<IMemory> outMemory = AddPoolAndGetData(numOutputs, request);
+    float* outdata = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+
+    Execute(preparedModel, request);
+
+    return std::vector<float>(outdata, outdata + numOutputs);
+}
+
+} // anonymous namespace
+
+// A per-channel shift, as produced by TFLite: [1,2,2,2] + [2]
+BOOST_AUTO_TEST_CASE(AddBroadcastsPerChannelTensor)
+{
+    V1_0::Model model = {};
+
+    float shift[] = {10, 20};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, shift);
+    AddIntOperand(model, 0);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+
+    model.operations.resize(1);
+    model.operations[0].type    = V1_0::OperationType::ADD;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2};
+    model.operations[0].outputs = hidl_vec<uint32_t>{3};
+
+    const std::vector<float> output = ExecuteFloatModel(model, {1, 2, 3, 4, 5, 6, 7, 8}, 8);
+    const std::vector<float> expected = {11, 22, 13, 24, 15, 26, 17, 28};
+    BOOST_TEST(output == expected, boost::test_tools::per_element());
+}
+
+// Both inputs are broadcast: [2,1] * [1,3] = [2,3]
+BOOST_AUTO_TEST_CASE(MulBroadcastsBothInputs)
+{
+    V1_0::Model model = {};
+
+    float scale[] = {1, 2, 3};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{2, 1});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 3}, scale);
+    AddIntOperand(model, 0);
+    AddOutputOperand(model, hidl_vec<uint32_t>{2, 3});
+
+    model.operations.resize(1);
+    model.operations[0].type    = V1_0::OperationType::MUL;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2};
+    model.operations[0].outputs = hidl_vec<uint32_t>{3};
+
+    const std::vector<float> output = ExecuteFloatModel(model, {1, 2}, 6);
+    const std::vector<float> expected = {1, 2, 3, 2, 4, 6};
+    BOOST_TEST(output == expected, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(IncompatibleBroadcastIsUnsupported)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    ErrorStatus error;
+    std::vector<bool> sup;
+
+    ArmnnDriver::getSupportedOperations_cb cb = [&](ErrorStatus status, const std::vector<bool>& supported)
+    {
+        error = status;
+        sup = supported;
+    };
+
+    V1_0::Model model = {};
+
+    // The last dimensions (3 and 2) neither match nor are 1
+    float scale[] = {1, 2};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 3});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, scale);
+    AddIntOperand(model, 0);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 3});
+
+    model.operations.resize(1);
+    model.operations[0].type    = V1_0::OperationType::MUL;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2};
+    model.operations[0].outputs = hidl_vec<uint32_t>{3};
+
+    driver->getSupportedOperations(model, cb);
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(sup[0] == false);
+}
+
+BOOST_AUTO_TEST_CASE(QuantizedAddAndMulAreSupported)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    ErrorStatus error;
+    std::vector<bool> sup;
+
+    ArmnnDriver::getSupportedOperations_cb cb = [&](ErrorStatus status, const std::vector<bool>& supported)
+    {
+        error = status;
+        sup = supported;
+    };
+
+    V1_0::Model model = {};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 1});
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 1});
+    AddIntOperand(model, 1); // relu
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 1});
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 1});
+
+    // Every tensor has its own quantization, so each result is rescaled
+    const float scales[]       = { 0.5f, 0.25f, 0, 1.0f, 0.2f };
+    const int32_t zeroPoints[] = { 10, 0, 0, 5, 0 };
+    for (uint32_t i : { 0u, 1u, 3u, 4u })
+    {
+        model.operands[i].type      = OperandType::TENSOR_QUANT8_ASYMM;
+        model.operands[i].scale     = scales[i];
+        model.operands[i].zeroPoint = zeroPoints[i];
+    }
+
+    model.operations.resize(2);
+    model.operations[0].type    = V1_0::OperationType::ADD;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2};
+    model.operations[0].outputs = hidl_vec<uint32_t>{3};
+
+    // The relu is redundant here, as the output's zero point is 0
+    model.operations[1].type    = V1_0::OperationType::MUL;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{0, 1, 2};
+    model.operations[1].outputs = hidl_vec<uint32_t>{4};
+
+    driver->getSupportedOperations(model, cb);
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(sup[0] == true);
+    BOOST_TEST(sup[1] == true);
+
+    // The output scale of a quantized MUL must be greater than the product of the input scales
+    model.operands[4].scale = 0.1f;
+    driver->getSupportedOperations(model, cb);
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(sup[0] == true);
+    BOOST_TEST(sup[1] == false);
+}
+
+namespace
+{
+
+// Reshapes the first operand to the given dimensions
+void AddReshapeOperation(V1_0::Model& model, uint32_t input, std::vector<int32_t> shape, uint32_t output)
+{
+    const uint32_t shapeOperand = model.operands.size();
+    AddTensorOperand(model, hidl_vec<uint32_t>{static_cast<uint32_t>(shape.size())}, shape.data());
+
+    const size_t operationIdx = model.operations.size();
+    model.operations.resize(operationIdx + 1);
+    model.operations[operationIdx].type    = V1_0::OperationType::RESHAPE;
+    model.operations[operationIdx].inputs  = hidl_vec<uint32_t>{input, shapeOperand};
+    model.operations[operationIdx].outputs = hidl_vec<uint32_t>{output};
+}
+
+// input [2,1,2,2] -> RESHAPE -> FULLY_CONNECTED with the given weights and bias
+V1_0::Model CreateReshapeFullyConnectedModel(std::vector<int32_t> shape, hidl_vec<uint32_t> weightsDims,
+                                             std::vector<float> weights, std::vector<float> bias)
+{
+    V1_0::Model model = {};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{2, 1, 2, 2});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{static_cast<uint32_t>(shape[0]), static_cast<uint32_t>(shape[1])});
+    AddTensorOperand(model, weightsDims, weights.data());
+    AddTensorOperand(model, hidl_vec<uint32_t>{weightsDims[0]}, bias.data());
+    AddIntOperand(model, 0);
+    AddOutputOperand(model, hidl_vec<uint32_t>{static_cast<uint32_t>(shape[0]), weightsDims[0]});
+
+    AddReshapeOperation(model, 0, shape, 1);
+
+    const size_t operationIdx = model.operations.size();
+    model.operations.resize(operationIdx + 1);
+    model.operations[operationIdx].type    = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[operationIdx].inputs  = hidl_vec<uint32_t>{1, 2, 3, 4};
+    model.operations[operationIdx].outputs = hidl_vec<uint32_t>{5};
+
+    return model;
+}
+
+// Returns the estimated cost of each operation, which is zero for those that were merged into another
+std::vector<armnn_driver::OperationCost> GetOperationCosts(const V1_0::Model& model)
+{
+    std::set<unsigned int> unsupportedOperations;
+    armnn_driver::ModelToINetworkConverter converter(armnn::Compute::CpuRef, model, unsupportedOperations);
+    BOOST_TEST((int)converter.GetConversionResult() == (int)armnn_driver::ConversionResult::Success);
+    return converter.GetOperationCosts();
+}
+
+} // anonymous namespace
+
+// The second reshape reads the model input directly, as only the final shape matters
+BOOST_AUTO_TEST_CASE(ReshapeChainIsCollapsed)
+{
+    V1_0::Model model = {};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 3, 1});
+    AddTemporaryOperand(model, hidl_vec<uint32_t>{6});
+    AddOutputOperand(model, hidl_vec<uint32_t>{3, 2});
+
+    AddReshapeOperation(model, 0, {6}, 1);
+    AddReshapeOperation(model, 1, {3, -1}, 2);
+
+    const std::vector<armnn_driver::OperationCost> costs = GetOperationCosts(model);
+    BOOST_TEST(costs[0].m_Bytes == 0.0);
+    BOOST_TEST(costs[1].m_Bytes > 0.0);
+
+    const std::vector<float> output = ExecuteFloatModel(model, {1, 2, 3, 4, 5, 6}, 6);
+    const std::vector<float> expected = {1, 2, 3, 4, 5, 6};
+    BOOST_TEST(output == expected, boost::test_tools::per_element());
+}
+
+// The fully connected layer flattens [2,1,2,2] to [2,4] itself, so the reshape is skipped
+BOOST_AUTO_TEST_CASE(ReshapeKeepingOuterDimensionIsCollapsedIntoFullyConnected)
+{
+    const V1_0::Model model = CreateReshapeFullyConnectedModel({2, 4}, hidl_vec<uint32_t>{3, 4},
+        {1, 0, 0, 0,
+         0, 1, 1, 0,
+         1, 1, 1, 1},
+        {0, 0, 1});
+
+    const std::vector<armnn_driver::OperationCost> costs = GetOperationCosts(model);
+    BOOST_TEST(costs[0].m_Bytes == 0.0);
+    BOOST_TEST(costs[1].m_Flops > 0.0);
+
+    const std::vector<float> output = ExecuteFloatModel(model, {1, 2, 3, 4, 5, 6, 7, 8}, 6);
+    const std::vector<float> expected = {1, 5, 11, 5, 13, 27};
+    BOOST_TEST(output == expected, boost::test_tools::per_element());
+}
+
+// The fully connected layer would flatten [2,1,2,2] to [2,4], not [4,2], so the reshape must be kept
+BOOST_AUTO_TEST_CASE(ReshapeChangingOuterDimensionIsNotCollapsedIntoFullyConnected)
+{
+    const V1_0::Model model = CreateReshapeFullyConnectedModel({4, 2}, hidl_vec<uint32_t>{3, 2},
+        {1, 0,
+         0, 1,
+         1, -1},
+        {0, 0, 0.5f});
+
+    const std::vector<armnn_driver::OperationCost> costs = GetOperationCosts(model);
+    BOOST_TEST(costs[0].m_Bytes > 0.0);
+    BOOST_TEST(costs[1].m_Flops > 0.0);
+
+    const std::vector<float> output = ExecuteFloatModel(model, {1, 2, 3, 4, 5, 6, 7, 8}, 12);
+    const std::vector<float> expected = {1, 2, -0.5f, 3, 4, -0.5f, 5, 6, -0.5f, 7, 8, -0.5f};
+    BOOST_TEST(output == expected, boost::test_tools::per_element());
+}
+
+// The reshape merged into the fully connected layer, and the RELU fused into it, are only supported where
+// the fully connected layer is, and run on the same device
+BOOST_AUTO_TEST_CASE(MergedOperationsTakeTheSupportOfTheOperationTheyAreMergedInto)
+{
+    V1_0::Model model = CreateReshapeFullyConnectedModel({2, 4}, hidl_vec<uint32_t>{3, 4},
+        {1, 0, 0, 0,
+         0, 1, 1, 0,
+         1, 1, 1, 1},
+        {0, 0, 1});
+    model.operands[5].lifetime = OperandLifeTime::TEMPORARY_VARIABLE;
+    model.outputIndexes = hidl_vec<uint32_t>{};
+    AddOutputOperand(model, hidl_vec<uint32_t>{2, 3});
+
+    model.operations.resize(3);
+    model.operations[2].type    = V1_0::OperationType::RELU;
+    model.operations[2].inputs  = hidl_vec<uint32_t>{5};
+    model.operations[2].outputs = hidl_vec<uint32_t>{6};
+
+    // No layer is supported on Compute::Undefined
+    std::set<unsigned int> unsupportedOperations;
+    armnn_driver::ModelToINetworkConverter converter(
+        std::vector<armnn::Compute>{armnn::Compute::Undefined}, model, unsupportedOperations);
+    BOOST_TEST(!converter.IsOperationSupported(0));
+    BOOST_TEST(!converter.IsOperationSupported(1));
+    BOOST_TEST(!converter.IsOperationSupported(2));
+
+    armnn_driver::ModelToINetworkConverter fallbackConverter(
+        std::vector<armnn::Compute>{armnn::Compute::Undefined, armnn::Compute::CpuRef}, model, unsupportedOperations);
+    BOOST_TEST((fallbackConverter.GetConversionResult() == armnn_driver::ConversionResult::Success));
+    for (uint32_t operationIdx = 0; operationIdx < 3; ++operationIdx)
+    {
+        BOOST_TEST(fallbackConverter.IsOperationSupported(operationIdx));
+        BOOST_TEST((fallbackConverter.GetOperationBackend(operationIdx) == armnn::Compute::CpuRef));
+    }
+}
+
+// A reshape to the shape its input already has adds no layer, so the model output is the model input
+BOOST_AUTO_TEST_CASE(IdentityReshapeOfModelInput)
+{
+    V1_0::Model model = {};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{2, 3});
+    AddOutputOperand(model, hidl_vec<uint32_t>{2, 3});
+
+    AddReshapeOperation(model, 0, {2, -1}, 1);
+
+    const std::vector<float> output = ExecuteFloatModel(model, {1, -2, 3, -4, 5, -6}, 6);
+    const std::vector<float> expected = {1, -2, 3, -4, 5, -6};
+    BOOST_TEST(output == expected, boost::test_tools::per_element());
+}
+
+// A 1x1 pool with unit strides and no padding adds no layer, so the model output is the model input
+BOOST_AUTO_TEST_CASE(IdentityPoolOfModelInput)
+{
+    V1_0::Model model = {};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+    AddIntOperand(model, 0); // no padding, no activation
+    AddIntOperand(model, 1); // strides, pool size
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+
+    model.operations.resize(1);
+    model.operations[0].type    = V1_0::OperationType::AVERAGE_POOL_2D;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 1, 1, 1, 2, 2, 2, 2, 1};
+    model.operations[0].outputs = hidl_vec<uint32_t>{3};
+
+    std::set<unsigned int> unsupportedOperations;
+    armnn_driver::ModelToINetworkConverter converter(armnn::Compute::CpuRef, model, unsupportedOperations);
+    BOOST_TEST((int)converter.GetConversionResult() == (int)armnn_driver::ConversionResult::Success);
+    BOOST_TEST(converter.GetNumPermuteLayers() == 0);
+
+    const std::vector<float> output = ExecuteFloatModel(model, {1, 2, 3, 4, 5, 6, 7, 8}, 8);
+    const std::vector<float> expected = {1, 2, 3, 4, 5, 6, 7, 8};
+    BOOST_TEST(output == expected, boost::test_tools::per_element());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
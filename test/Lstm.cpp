@@ -0,0 +1,208 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+#include "DriverTestHelpers.hpp"
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(LstmTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using DriverOptions = armnn_driver::DriverOptions;
+using namespace driverTestHelpers;
+
+namespace
+{
+
+// Runs a model with the LSTM's input, output state and cell state as its inputs, and its scratch buffer,
+// output state, cell state and output as its outputs, each in a pool of its own.
+std::vector<std::vector<float>> ExecuteLstmModel(const V1_0::Model& model,
+                                                 const std::vector<std::vector<float>>& inputs,
+                                                 const std::vector<uint32_t>& outputSizes)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+
+    Request request = {};
+    request.inputs.resize(inputs.size());
+    request.outputs.resize(outputSizes.size());
+
+    uint32_t poolIndex = 0;
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        request.inputs[i].location.poolIndex = poolIndex++;
+        request.inputs[i].location.offset    = 0;
+        request.inputs[i].location.length    = inputs[i].size() * sizeof(float);
+        request.inputs[i].dimensions         = hidl_vec<uint32_t>{};
+        AddPoolAndSetData(inputs[i].size(), request, inputs[i].data());
+    }
+
+    std::vector<android::sp<IMemory>> outMemories;
+    for (size_t i = 0; i < outputSizes.size(); ++i)
+    {
+        request.outputs[i].location.poolIndex = poolIndex++;
+        request.outputs[i].location.offset    = 0;
+        request.outputs[i].location.length    = outputSizes[i] * sizeof(float);
+        request.outputs[i].dimensions         = hidl_vec<uint32_t>{};
+        outMemories.push_back(AddPoolAndGetData(outputSizes[i], request));
+    }
+
+    Execute(preparedModel, request);
+
+    std::vector<std::vector<float>> outputs;
+    for (size_t i = 0; i < outputSizes.size(); ++i)
+    {
+        const float* outdata = static_cast<float*>(static_cast<void*>(outMemories[i]->getPointer()));
+        outputs.emplace_back(outdata, outdata + outputSizes[i]);
+    }
+    return outputs;
+}
+
+void CheckValues(const std::vector<float>& actual, const std::vector<float>& expected)
+{
+    BOOST_TEST(actual.size() == expected.size());
+    for (size_t i = 0; i < std::min(actual.size(), expected.size()); ++i)
+    {
+        BOOST_TEST(std::fabs(actual[i] - expected[i]) < 1e-5f);
+    }
+}
+
+} // namespace <anonymous>
+
+BOOST_AUTO_TEST_CASE(LstmBasicCell)
+{
+    // batch size 1, input size 2, 1 unit, output size 1, without CIFG, peephole or projection
+    V1_0::Model model = {};
+
+    float inputToInputWeights[]      = {0.5f, -0.5f};
+    float inputToForgetWeights[]     = {1.0f, 0.0f};
+    float inputToCellWeights[]       = {0.0f, 1.0f};
+    float inputToOutputWeights[]     = {1.0f, 1.0f};
+    float recurrentToInputWeights[]  = {1.0f};
+    float recurrentToForgetWeights[] = {-1.0f};
+    float recurrentToCellWeights[]   = {0.5f};
+    float recurrentToOutputWeights[] = {0.0f};
+    float inputGateBias[]            = {0.0f};
+    float forgetGateBias[]           = {1.0f};
+    float cellBias[]                 = {0.0f};
+    float outputGateBias[]           = {-1.0f};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 2}, inputToInputWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 2}, inputToForgetWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 2}, inputToCellWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 2}, inputToOutputWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 1}, recurrentToInputWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 1}, recurrentToForgetWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 1}, recurrentToCellWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 1}, recurrentToOutputWeights);
+    AddNoValueOperand(model, hidl_vec<uint32_t>{0}); // cell to input weights
+    AddNoValueOperand(model, hidl_vec<uint32_t>{0}); // cell to forget weights
+    AddNoValueOperand(model, hidl_vec<uint32_t>{0}); // cell to output weights
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, inputGateBias);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, forgetGateBias);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, cellBias);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, outputGateBias);
+    AddNoValueOperand(model, hidl_vec<uint32_t>{0, 0}); // projection weights
+    AddNoValueOperand(model, hidl_vec<uint32_t>{0}); // projection bias
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 1}); // output state in
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 1}); // cell state in
+    AddIntOperand(model, 4); // tanh
+    AddFloatOperand(model, 0.0f); // no cell clip
+    AddFloatOperand(model, 0.0f); // no projection clip
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 4}); // scratch buffer
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1}); // output state out
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1}); // cell state out
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1}); // output
+
+    model.operations.resize(1);
+    model.operations[0].type = V1_0::OperationType::LSTM;
+    model.operations[0].inputs.resize(23);
+    for (uint32_t i = 0; i < 23; ++i)
+    {
+        model.operations[0].inputs[i] = i;
+    }
+    model.operations[0].outputs = hidl_vec<uint32_t>{23, 24, 25, 26};
+
+    const std::vector<std::vector<float>> outputs =
+        ExecuteLstmModel(model, { {1.0f, 2.0f}, {0.5f}, {2.0f} }, {4, 1, 1, 1});
+
+    // gates = {0, 1.5, 2.25, 2}, cell state = sigmoid(1.5) * 2 + sigmoid(0) * tanh(2.25),
+    // output = sigmoid(2) * tanh(cell state)
+    CheckValues(outputs[0], {0.0f, 1.5f, 2.25f, 2.0f});
+    CheckValues(outputs[1], {0.8559817f});
+    CheckValues(outputs[2], {2.1241620f});
+    CheckValues(outputs[3], {0.8559817f});
+}
+
+BOOST_AUTO_TEST_CASE(LstmCifgPeepholeProjectionAndClipping)
+{
+    // batch size 1, input size 1, 2 units, output size 1
+    V1_0::Model model = {};
+
+    float inputToForgetWeights[]     = {0.5f, 1.0f};
+    float inputToCellWeights[]       = {1.0f, -1.0f};
+    float inputToOutputWeights[]     = {0.25f, 0.5f};
+    float recurrentToForgetWeights[] = {1.0f, 0.0f};
+    float recurrentToCellWeights[]   = {0.5f, 0.5f};
+    float recurrentToOutputWeights[] = {-1.0f, 1.0f};
+    float cellToForgetWeights[]      = {0.5f, -0.5f};
+    float cellToOutputWeights[]      = {1.0f, 0.25f};
+    float forgetGateBias[]           = {0.0f, 0.5f};
+    float cellBias[]                 = {0.0f, 0.0f};
+    float outputGateBias[]           = {0.5f, 0.0f};
+    float projectionWeights[]        = {0.5f, -1.0f};
+    float projectionBias[]           = {0.1f};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 1});
+    AddNoValueOperand(model, hidl_vec<uint32_t>{0, 0}); // input to input weights
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1}, inputToForgetWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1}, inputToCellWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1}, inputToOutputWeights);
+    AddNoValueOperand(model, hidl_vec<uint32_t>{0, 0}); // recurrent to input weights
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1}, recurrentToForgetWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1}, recurrentToCellWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 1}, recurrentToOutputWeights);
+    AddNoValueOperand(model, hidl_vec<uint32_t>{0}); // cell to input weights
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, cellToForgetWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, cellToOutputWeights);
+    AddNoValueOperand(model, hidl_vec<uint32_t>{0}); // input gate bias
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, forgetGateBias);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, cellBias);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, outputGateBias);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 2}, projectionWeights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, projectionBias);
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 1}); // output state in
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2}); // cell state in
+    AddIntOperand(model, 4); // tanh
+    AddFloatOperand(model, 1.5f); // cell clip
+    AddFloatOperand(model, 0.3f); // projection clip
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 6}); // scratch buffer
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1}); // output state out
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2}); // cell state out
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1}); // output
+
+    model.operations.resize(1);
+    model.operations[0].type = V1_0::OperationType::LSTM;
+    model.operations[0].inputs.resize(23);
+    for (uint32_t i = 0; i < 23; ++i)
+    {
+        model.operations[0].inputs[i] = i;
+    }
+    model.operations[0].outputs = hidl_vec<uint32_t>{23, 24, 25, 26};
+
+    const std::vector<std::vector<float>> outputs =
+        ExecuteLstmModel(model, { {2.0f}, {-1.0f}, {0.5f, -3.0f} }, {6, 1, 2, 1});
+
+    // The input gate is 1 - forget gate, the second unit's cell state (about -2.96) is clipped to -1.5,
+    // and the projection (about 0.745) is clipped to 0.3
+    CheckValues(outputs[0], {0.0f, 2.5f, 1.5f, -2.5f, 2.0f, 0.0f});
+    CheckValues(outputs[1], {0.3f});
+    CheckValues(outputs[2], {0.6773834f, -1.5f});
+    CheckValues(outputs[3], {0.3f});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -286,6 +286,126 @@ BOOST_AUTO_TEST_CASE(SimpleConcatAxis3_DoInterleave)
     MergerTestImpl({&aIn, &bIn, &cIn}, axis, expected);
 }
 
+BOOST_AUTO_TEST_CASE(Concat2DAxis0)
+{
+    int32_t axis = 0;
+    TestTensor aIn{armnn::TensorShape{1,2},{0, 1}};
+    TestTensor bIn{armnn::TensorShape{2,2},{2, 3,
+                                            4, 5}};
+
+    TestTensor expected{armnn::TensorShape{3,2},{0, 1,
+                                                 2, 3,
+                                                 4, 5}};
+
+    MergerTestImpl({&aIn, &bIn}, axis, expected);
+}
+
+BOOST_AUTO_TEST_CASE(Concat2DAxis1)
+{
+    int32_t axis = 1;
+    TestTensor aIn{armnn::TensorShape{2,1},{0,
+                                            1}};
+    TestTensor bIn{armnn::TensorShape{2,2},{2, 3,
+                                            4, 5}};
+
+    TestTensor expected{armnn::TensorShape{2,3},{0, 2, 3,
+                                                 1, 4, 5}};
+
+    MergerTestImpl({&aIn, &bIn}, axis, expected);
+}
+
+BOOST_AUTO_TEST_CASE(Concat3DAxis1)
+{
+    int32_t axis = 1;
+    TestTensor aIn{armnn::TensorShape{2,1,2},{0, 1,
+                                              2, 3}};
+    TestTensor bIn{armnn::TensorShape{2,2,2},{4,  5,  6,  7,
+                                              8,  9, 10, 11}};
+
+    TestTensor expected{armnn::TensorShape{2,3,2},{0, 1, 4,  5,  6,  7,
+                                                   2, 3, 8,  9, 10, 11}};
+
+    MergerTestImpl({&aIn, &bIn}, axis, expected);
+}
+
+BOOST_AUTO_TEST_CASE(Concat3DAxis2)
+{
+    int32_t axis = 2;
+    TestTensor aIn{armnn::TensorShape{1,2,1},{0,
+                                              1}};
+    TestTensor bIn{armnn::TensorShape{1,2,2},{2, 3,
+                                              4, 5}};
+
+    TestTensor expected{armnn::TensorShape{1,2,3},{0, 2, 3,
+                                                   1, 4, 5}};
+
+    MergerTestImpl({&aIn, &bIn}, axis, expected);
+}
+
+BOOST_AUTO_TEST_CASE(MismatchedInputDimensionsWithSameView)
+{
+    int32_t axis = 2;
+    TestTensor aIn{armnn::TensorShape{2,3,1,1},{0, 1, 2, 3, 4, 5}};
+    TestTensor bIn{armnn::TensorShape{3,2,1,1},{6, 7, 8, 9, 10, 11}};
+    TestTensor expected{armnn::TensorShape{2,3,2,1},{0, 6, 1, 7, 2, 8, 3, 9, 4, 10, 5, 11}};
+
+    // The inputs must have the same dimensions other than along the axis, even if their sizes match
+    ErrorStatus expectedParserStatus = ErrorStatus::GENERAL_FAILURE;
+    MergerTestImpl({&aIn, &bIn}, axis, expected, expectedParserStatus);
+}
+
+BOOST_AUTO_TEST_CASE(QuantizedConcatWithDifferentQuantizationIsSupported)
+{
+    std::unique_ptr<ArmnnDriver> driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    V1_0::Model model{};
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 1});
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 2});
+    AddIntOperand(model, 3);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2, 2, 3});
+
+    // The first input matches the output, the second needs requantizing
+    const float scales[]      = { 0.5f, 0.25f, 0, 0.5f };
+    const int32_t zeroPoints[] = { 10, 0, 0, 10 };
+    for (uint32_t i : { 0u, 1u, 3u })
+    {
+        model.operands[i].type      = OperandType::TENSOR_QUANT8_ASYMM;
+        model.operands[i].scale     = scales[i];
+        model.operands[i].zeroPoint = zeroPoints[i];
+    }
+
+    model.operations.resize(1);
+    model.operations[0].type    = V1_0::OperationType::CONCATENATION;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2};
+    model.operations[0].outputs = hidl_vec<uint32_t>{3};
+
+    ErrorStatus error;
+    std::vector<bool> supported;
+    driver->getSupportedOperations(model, [&](ErrorStatus status, const std::vector<bool>& result)
+    {
+        error = status;
+        supported = result;
+    });
+
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(supported.size() == 1);
+    BOOST_TEST(supported[0] == true);
+
+    // Mixing quantized and float inputs is not supported
+    model.operands[1].type      = OperandType::TENSOR_FLOAT32;
+    model.operands[1].scale     = 0.0f;
+    model.operands[1].zeroPoint = 0;
+    driver->getSupportedOperations(model, [&](ErrorStatus status, const std::vector<bool>& result)
+    {
+        error = status;
+        supported = result;
+    });
+
+    BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+    BOOST_TEST(supported.size() == 1);
+    BOOST_TEST(supported[0] == false);
+}
+
 BOOST_AUTO_TEST_CASE(AxisTooBig)
 {
     int32_t axis = 4;
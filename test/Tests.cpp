@@ -15,6 +15,23 @@ using ArmnnDriver = armnn_driver::ArmnnDriver;
 using DriverOptions = armnn_driver::DriverOptions;
 using namespace driverTestHelpers;
 
+namespace
+{
+
+// Parses the given arguments as the driver's command line
+DriverOptions ParseDriverOptions(std::vector<std::string> args)
+{
+    args.insert(args.begin(), "armnn-driver");
+    std::vector<char*> argv;
+    for (std::string& arg : args)
+    {
+        argv.push_back(&arg[0]);
+    }
+    return DriverOptions(static_cast<int>(argv.size()), argv.data());
+}
+
+} // namespace <anonymous>
+
 BOOST_AUTO_TEST_CASE(Init)
 {
     // Making the driver object on the stack causes a weird libc error, so make it on the heap instead
@@ -48,4 +65,26 @@ BOOST_AUTO_TEST_CASE(TestCapabilities)
     BOOST_TEST(cap.quantized8Performance.powerUsage > 0.f);
 }
 
+BOOST_AUTO_TEST_CASE(ComputeDeviceWithFallback)
+{
+    const DriverOptions options = ParseDriverOptions({"--compute", "CpuAcc,CpuRef"});
+
+    BOOST_TEST((options.GetComputeDevice() == armnn::Compute::CpuAcc));
+    BOOST_TEST((options.GetBackends() == std::vector<armnn::Compute>{armnn::Compute::CpuAcc, armnn::Compute::CpuRef}));
+    BOOST_TEST(options.UseCpuRefAsFallback());
+}
+
+BOOST_AUTO_TEST_CASE(UnsupportedFallbackIsIgnored)
+{
+    // Only CpuRef can be a fallback, so GpuAcc is ignored (with a warning), as are unknown devices
+    const DriverOptions options = ParseDriverOptions({"--compute", "CpuAcc,GpuAcc"});
+    BOOST_TEST((options.GetBackends() == std::vector<armnn::Compute>{armnn::Compute::CpuAcc}));
+    BOOST_TEST(!options.UseCpuRefAsFallback());
+
+    const DriverOptions optionsWithUnknownDevice = ParseDriverOptions({"--compute", "CpuAcc,NotADevice,CpuRef"});
+    BOOST_TEST((optionsWithUnknownDevice.GetBackends() ==
+                std::vector<armnn::Compute>{armnn::Compute::CpuAcc, armnn::Compute::CpuRef}));
+    BOOST_TEST(optionsWithUnknownDevice.UseCpuRefAsFallback());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -256,4 +256,33 @@ BOOST_AUTO_TEST_CASE(ExportMultipleNetworks)
     BOOST_TEST(fixture3.GetFileContent() == mockSerializedContent);
 }
 
+BOOST_AUTO_TEST_CASE(MeasureSparsityOfFloatWeights)
+{
+    // Two zero blocks of 4, a block with a single zero and a partial block of 2 zeros
+    const float weights[] = { 0, 0, 0, 0,
+                              1, 0, 2, 3,
+                              0, 0, 0, 0,
+                              0, 0 };
+    const armnn::ConstTensor tensor(armnn::TensorInfo({ 14 }, armnn::DataType::Float32), weights);
+
+    const WeightSparsity sparsity = MeasureWeightSparsity(tensor, 4);
+    BOOST_TEST(sparsity.m_NumElements == 14);
+    BOOST_TEST(sparsity.m_NumZeros == 11);
+    BOOST_TEST(sparsity.m_NumBlocks == 4);
+    BOOST_TEST(sparsity.m_NumZeroBlocks == 3);
+    BOOST_TEST(sparsity.GetZeroBlockFraction() == 0.75f);
+}
+
+BOOST_AUTO_TEST_CASE(MeasureSparsityOfQuantizedWeights)
+{
+    // Zero is represented by the quantization offset
+    const uint8_t weights[] = { 128, 128, 0, 128 };
+    const armnn::ConstTensor tensor(armnn::TensorInfo({ 4 }, armnn::DataType::QuantisedAsymm8, 0.5f, 128), weights);
+
+    const WeightSparsity sparsity = MeasureWeightSparsity(tensor, 2);
+    BOOST_TEST(sparsity.m_NumZeros == 3);
+    BOOST_TEST(sparsity.m_NumZeroBlocks == 1);
+    BOOST_TEST(sparsity.GetZeroFraction() == 0.75f);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
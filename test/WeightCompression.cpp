@@ -0,0 +1,85 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// See LICENSE file in the project root for full license information.
+//
+#include "DriverTestHelpers.hpp"
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include "../WeightCompression.hpp"
+
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(WeightCompressionTests)
+
+using namespace armnn_driver;
+using namespace driverTestHelpers;
+
+BOOST_AUTO_TEST_CASE(RowsQuantizeWithinHalfAStep)
+{
+    const float weights[] = { 1.0f, -0.45f, 0.25f, 0.1f,
+                              0.0f,  0.0f, 0.0f,  0.0f,
+                              -254.0f, 3.2f, 127.0f, 0.6f };
+
+    const RowQuantizedWeights quantized = QuantizeRowsToInt8(weights, 3, 4);
+    BOOST_TEST(quantized.m_Values.size() == 12);
+    BOOST_TEST(quantized.m_RowScales.size() == 3);
+
+    // The largest magnitude in each row maps to +-127
+    BOOST_TEST(quantized.m_Values[0] == 127);
+    BOOST_TEST(quantized.m_Values[8] == -127);
+    BOOST_TEST(quantized.m_RowScales[2] == 2.0f);
+
+    float dequantized[12];
+    DequantizeRows(quantized, 4, dequantized);
+    for (unsigned int i = 0; i < 12; ++i)
+    {
+        BOOST_TEST(std::fabs(dequantized[i] - weights[i]) <= quantized.m_RowScales[i / 4] / 2.0f);
+    }
+
+    // An all-zero row stays exact
+    for (unsigned int i = 4; i < 8; ++i)
+    {
+        BOOST_TEST(dequantized[i] == 0.0f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(FullyConnectedWeightsAreEstimated)
+{
+    V1_0::Model model = {};
+
+    float weights[] = { 0.3f, -0.7f, 1.1f, 0.05f,
+                        2.0f,  0.9f, -0.2f, 0.0f };
+    float bias[] = { 0.0f, 0.0f };
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 4});
+    AddTensorOperand(model, hidl_vec<uint32_t>{2, 4}, weights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{2}, bias);
+    AddIntOperand(model, 0);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 2});
+
+    model.operations.resize(1);
+    model.operations[0].type    = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    // Too small to be considered
+    BOOST_TEST(EstimateFullyConnectedWeightCompression(model, 1024.0).empty());
+
+    const std::vector<WeightCompressionEstimate> estimates = EstimateFullyConnectedWeightCompression(model, 0.0);
+    BOOST_TEST(estimates.size() == 1);
+    if (estimates.size() != 1)
+    {
+        return;
+    }
+
+    // 8 int8 values plus 2 float scales
+    BOOST_TEST(estimates[0].m_OperationIndex == 0);
+    BOOST_TEST(estimates[0].m_FloatBytes == 32.0);
+    BOOST_TEST(estimates[0].m_CompressedBytes == 16.0);
+    BOOST_TEST(estimates[0].m_MaxWeightError <= 2.0f / 127.0f / 2.0f);
+    BOOST_TEST(estimates[0].m_MaxOutputError <= 4 * estimates[0].m_MaxWeightError);
+    BOOST_TEST(estimates[0].m_MaxOutput > 0.0f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()